@@ -0,0 +1,10 @@
+TARGET = Linechart-Benchmark
+
+QT = core charts gui
+
+CONFIG += c++17 cmdline
+
+include(../ChartRendering/ChartRendering.pri)
+
+SOURCES += \
+        main.cpp
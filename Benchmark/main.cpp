@@ -0,0 +1,278 @@
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QVector>
+#include <QDebug>
+
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+#include "ChartRendering.h"
+
+static QJsonObject createLineChartObject(int seriesCount, int pointCount, int width, int height)
+{
+    QJsonArray seriesArray;
+
+    for (int series {0}; series < seriesCount; ++series)
+    {
+        QJsonArray xPoints;
+        QJsonArray yPoints;
+
+        for (int point {0}; point < pointCount; ++point)
+        {
+            xPoints << static_cast<double>(point) * 10.0 / pointCount;
+            yPoints << 5.0 + 4.0 * std::sin(point * 0.05 + series);
+        }
+
+        seriesArray << QJsonObject
+        {
+            {"Caption",  QString{"Series %0"}.arg(series)},
+            {"X_Points", xPoints},
+            {"Y_Points", yPoints}
+        };
+    }
+
+    return QJsonObject
+    {
+        {"X_Start", 0},
+        {"X_End",   10},
+        {"Width",   width},
+        {"Height",  height},
+        {"Points",  QJsonArray{QJsonValue{seriesArray}}}
+    };
+}
+
+static QString formatTimings(const QString &stage, QVector<qint64> timings)
+{
+    std::sort(timings.begin(), timings.end());
+
+    const double mean {std::accumulate(timings.begin(), timings.end(), 0.0) / timings.size()};
+
+    return QString{"%0: min %1 ms, median %2 ms, p95 %3 ms, mean %4 ms"}
+            .arg(stage, -7)
+            .arg(timings.first() / 1e6, 0, 'f', 3)
+            .arg(timings.at(timings.size() / 2) / 1e6, 0, 'f', 3)
+            .arg(timings.at(std::min<int>(timings.size() - 1, static_cast<int>(timings.size() * 0.95))) / 1e6, 0, 'f', 3)
+            .arg(mean / 1e6, 0, 'f', 3);
+}
+
+//views on the rows of image, as the banded render pipeline hands them to the PNG writers
+static QVector<QImage> splitIntoBands(const QImage &image, int bandHeight)
+{
+    QVector<QImage> bands;
+
+    for (int top {0}; top < image.height(); top += bandHeight)
+        bands << QImage {image.constScanLine(top), image.width(), std::min(bandHeight, image.height() - top), image.bytesPerLine(), image.format()};
+
+    return bands;
+}
+
+int main(int argc, char *argv[])
+{
+    selectOffscreenPlatform();
+
+    QApplication app {argc, argv};
+
+    QCoreApplication::setApplicationName("LineChart-Benchmark");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser commandlineParser;
+    commandlineParser.addHelpOption();
+    commandlineParser.addVersionOption();
+    commandlineParser.setApplicationDescription("Measures parse, render and encode time of the ChartRendering library.");
+
+    const QCommandLineOption iterationsOption  {"iterations",  "Number of measured <iterations>.", "iterations", "50"};
+    const QCommandLineOption seriesOption      {"series",      "Number of <series> per chart.", "series", "4"};
+    const QCommandLineOption pointsOption      {"points",      "Number of <points> per series.", "points", "1000"};
+    const QCommandLineOption compressionOption {"compression", "PNG compression <level> from 0 to 9.", "level", "-1"};
+    const QCommandLineOption widthOption       {"width",       "Chart <width> in pixels.", "width", "1024"};
+    const QCommandLineOption heightOption      {"height",      "Chart <height> in pixels.", "height", "768"};
+
+    commandlineParser.addOption(iterationsOption);
+    commandlineParser.addOption(seriesOption);
+    commandlineParser.addOption(pointsOption);
+    commandlineParser.addOption(compressionOption);
+    commandlineParser.addOption(widthOption);
+    commandlineParser.addOption(heightOption);
+    commandlineParser.process(app);
+
+    const int iterations {std::max(commandlineParser.value(iterationsOption).toInt(), 1)};
+
+    const QJsonObject jsonObject {createLineChartObject(std::max(commandlineParser.value(seriesOption).toInt(), 1),
+                                                        std::max(commandlineParser.value(pointsOption).toInt(), 1),
+                                                        commandlineParser.value(widthOption).toInt(),
+                                                        commandlineParser.value(heightOption).toInt())};
+
+    const int compressionLevel {commandlineParser.value(compressionOption).toInt()};
+    const PngEncoder pngEncoder {compressionLevel};
+
+    QImage lastImage;
+
+    QVector<qint64> parseTimings;
+    QVector<qint64> renderTimings;
+    QVector<qint64> encodeTimings;
+
+    qint64 encodedBytes {0};
+
+    //one unmeasured round pays for font loading and the QtCharts initialization
+    for (int iteration {-1}; iteration < iterations; ++iteration)
+    {
+        QElapsedTimer stageTimer;
+
+        LineChartSpec spec;
+        QString errorMessage;
+
+        stageTimer.start();
+
+        if (!parseLineChartSpec(jsonObject, &spec, &errorMessage))
+        {
+            qCritical().noquote() << errorMessage;
+            return -1;
+        }
+
+        const qint64 parseTime {stageTimer.nsecsElapsed()};
+
+        stageTimer.restart();
+        const QImage image {renderLineChart(spec)};
+        const qint64 renderTime {stageTimer.nsecsElapsed()};
+
+        lastImage = image;
+
+        QByteArray bytes;
+
+        stageTimer.restart();
+        pngEncoder.encode(image, &bytes);
+        const qint64 encodeTime {stageTimer.nsecsElapsed()};
+
+        if (iteration < 0)
+            continue;
+
+        parseTimings  << parseTime;
+        renderTimings << renderTime;
+        encodeTimings << encodeTime;
+
+        encodedBytes += bytes.size();
+    }
+
+    qInfo().noquote() << formatTimings("parse",  parseTimings);
+    qInfo().noquote() << formatTimings("render", renderTimings);
+    qInfo().noquote() << formatTimings("encode", encodeTimings);
+    qInfo().noquote() << QString{"average PNG size: %0 bytes"}.arg(encodedBytes / iterations);
+
+    //every encoder that was built, on the same chart
+    const QVector<QImage> bands {splitIntoBands(lastImage, 128)};
+
+    QVector<QPair<QString, std::function<bool(QByteArray *)> > > encoders;
+
+    for (const PngEncoder::Backend backend : PngEncoder::availableBackends())
+    {
+        encoders << qMakePair(QString{"PngEncoder (%0)"}.arg(PngEncoder::backendName(backend)), [&lastImage, encoder = PngEncoder{compressionLevel, backend}](QByteArray *bytes)
+        {
+            return encoder.encode(lastImage, bytes);
+        });
+    }
+
+#ifdef LINECHART_ZLIBNG
+    const QString deflateLibrary {"zlib-ng"};
+#else
+    const QString deflateLibrary {"zlib"};
+#endif
+
+    encoders << qMakePair(QString{"PngStreamWriter (%0)"}.arg(deflateLibrary), [&lastImage, &bands, compressionLevel](QByteArray *bytes)
+    {
+        PngStreamWriter pngWriter {lastImage.size(), compressionLevel, bytes};
+
+        return std::all_of(bands.begin(), bands.end(), [&pngWriter](const QImage &band) { return pngWriter.writeRows(band); }) && pngWriter.finish();
+    });
+
+    encoders << qMakePair(QString{"ParallelPngWriter (%0)"}.arg(deflateLibrary), [&lastImage, &bands, compressionLevel](QByteArray *bytes)
+    {
+        ParallelPngWriter pngWriter {lastImage.size(), compressionLevel, QThreadPool::globalInstance(), bytes};
+
+        return std::all_of(bands.begin(), bands.end(), [&pngWriter](const QImage &band) { return pngWriter.writeRows(band); }) && pngWriter.finish();
+    });
+
+    const double megapixels {lastImage.width() * lastImage.height() / 1e6};
+
+    qInfo().noquote() << QString{"encoders on a %0x%1 chart:"}.arg(lastImage.width()).arg(lastImage.height());
+
+    for (const QPair<QString, std::function<bool(QByteArray *)> > &encoder : encoders)
+    {
+        QVector<qint64> timings;
+        QByteArray bytes;
+
+        for (int iteration {0}; iteration < iterations; ++iteration)
+        {
+            QElapsedTimer encodeTimer;
+            encodeTimer.start();
+
+            if (!encoder.second(&bytes))
+            {
+                qWarning().noquote() << encoder.first << "failed";
+                break;
+            }
+
+            timings << encodeTimer.nsecsElapsed();
+        }
+
+        if (timings.isEmpty())
+            continue;
+
+        std::sort(timings.begin(), timings.end());
+
+        const qint64 median {timings.at(timings.size() / 2)};
+
+        qInfo().noquote() << QString{"%0: median %1 ms, %2 MPixel/s, %3 bytes"}
+                             .arg(encoder.first, -30)
+                             .arg(median / 1e6, 0, 'f', 3)
+                             .arg(megapixels / (std::max(median, qint64{1}) / 1e9), 0, 'f', 1)
+                             .arg(bytes.size());
+    }
+
+    //render and encode together, the way the server produces a chart
+    LineChartSpec spec;
+    parseLineChartSpec(jsonObject, &spec, nullptr);
+
+    const QVector<QPair<QString, std::function<bool(QByteArray *)> > > pipelines
+    {
+        qMakePair(QString{"renderLineChart + PngEncoder"}, [&spec, &pngEncoder](QByteArray *bytes)
+        {
+            return pngEncoder.encode(renderLineChart(spec), bytes);
+        }),
+        qMakePair(QString{"renderLineChartPngStreamed"}, [&spec, compressionLevel](QByteArray *bytes)
+        {
+            return renderLineChartPngStreamed(spec, compressionLevel, QThreadPool::globalInstance(), bytes);
+        })
+    };
+
+    qInfo().noquote() << "render and encode:";
+
+    for (const QPair<QString, std::function<bool(QByteArray *)> > &pipeline : pipelines)
+    {
+        QVector<qint64> timings;
+        QByteArray bytes;
+
+        for (int iteration {0}; iteration < iterations; ++iteration)
+        {
+            QElapsedTimer pipelineTimer;
+            pipelineTimer.start();
+
+            if (!pipeline.second(&bytes))
+            {
+                qWarning().noquote() << pipeline.first << "failed";
+                break;
+            }
+
+            timings << pipelineTimer.nsecsElapsed();
+        }
+
+        if (!timings.isEmpty())
+            qInfo().noquote() << formatTimings(pipeline.first, timings);
+    }
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include "BatchRenderer.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QJsonDocument>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QFuture>
+#include <QFile>
+#include <QDir>
+
+#include <algorithm>
+#include <atomic>
+
+#include "LineChartRenderer.h"
+#include "LineChartSpec.h"
+#include "PngEncoder.h"
+
+namespace
+{
+    struct BatchRecord
+    {
+        qint64        line {0};
+        QByteArray    json;
+        LineChartSpec spec;
+        QImage        image;
+        QByteArray    bytes;
+        QString       errorMessage;
+    };
+
+    struct StageTimes
+    {
+        std::atomic<qint64> parse  {0};
+        std::atomic<qint64> render {0};
+        std::atomic<qint64> encode {0};
+        std::atomic<qint64> write  {0};
+    };
+}
+
+BatchRenderer::BatchRenderer(const QString &outputDirectory, int renderThreads, int compressionLevel) :
+    m_outputDirectory  {outputDirectory},
+    m_renderThreads    {std::max(renderThreads, 1)},
+    m_compressionLevel {compressionLevel}
+{
+
+}
+
+bool BatchRenderer::run(const QString &inputFilename, Report *report) const
+{
+    QFile inputFile {inputFilename};
+
+    if (!inputFile.open(QFile::OpenModeFlag::ReadOnly | QFile::OpenModeFlag::Text))
+        return false;
+
+    if (!QDir{}.mkpath(m_outputDirectory))
+        return false;
+
+    QThreadPool parsePool;
+    QThreadPool renderPool;
+    QThreadPool encodePool;
+    QThreadPool writePool;
+
+    parsePool.setMaxThreadCount(std::max(m_renderThreads / 4, 1));
+    renderPool.setMaxThreadCount(m_renderThreads);
+    encodePool.setMaxThreadCount(m_renderThreads);
+    writePool.setMaxThreadCount(2);
+
+    //bounds the records in flight, so decoded images don't pile up in front of a slower stage
+    QSemaphore inFlight {m_renderThreads * 4};
+
+    StageTimes stageTimes;
+
+    std::atomic<qint64> rendered {0};
+    std::atomic<qint64> failed   {0};
+    std::atomic<qint64> bytes    {0};
+
+    const QString outputDirectory {m_outputDirectory};
+    const PngEncoder pngEncoder   {m_compressionLevel};
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    QList<QFuture<void> > pipelines;
+    qint64 line {0};
+
+    while (!inputFile.atEnd())
+    {
+        const QByteArray json {inputFile.readLine().trimmed()};
+        ++line;
+
+        if (json.isEmpty())
+            continue;
+
+        inFlight.acquire();
+
+        pipelines << QtConcurrent::run(&parsePool, [&stageTimes](BatchRecord record)
+        {
+            QElapsedTimer stageTimer;
+            stageTimer.start();
+
+            const QJsonDocument jsonDocument {QJsonDocument::fromJson(record.json)};
+
+            if (!jsonDocument.isObject() || jsonDocument.object().isEmpty())
+                record.errorMessage = "Invalid data sent. Please send a valid JSON-Object.";
+            else
+                parseLineChartSpec(jsonDocument.object(), &record.spec, &record.errorMessage);
+
+            record.json.clear();
+
+            stageTimes.parse.fetch_add(stageTimer.nsecsElapsed());
+            return record;
+
+        }, BatchRecord{line, json, {}, {}, {}, {}})
+        .then(&renderPool, [&stageTimes](BatchRecord record)
+        {
+            if (!record.errorMessage.isEmpty())
+                return record;
+
+            QElapsedTimer stageTimer;
+            stageTimer.start();
+
+            record.image = renderLineChart(record.spec);
+
+            stageTimes.render.fetch_add(stageTimer.nsecsElapsed());
+            return record;
+        })
+        .then(&encodePool, [&stageTimes, &pngEncoder](BatchRecord record)
+        {
+            if (!record.errorMessage.isEmpty())
+                return record;
+
+            QElapsedTimer stageTimer;
+            stageTimer.start();
+
+            if (!pngEncoder.encode(record.image, &record.bytes))
+                record.errorMessage = "The chart could not be encoded.";
+
+            record.image = {};
+
+            stageTimes.encode.fetch_add(stageTimer.nsecsElapsed());
+            return record;
+        })
+        .then(&writePool, [&stageTimes, &inFlight, &rendered, &failed, &bytes, outputDirectory](BatchRecord record)
+        {
+            QElapsedTimer stageTimer;
+            stageTimer.start();
+
+            if (record.errorMessage.isEmpty())
+            {
+                QFile outputFile {outputDirectory + QDir::separator() + QString{"%0.png"}.arg(record.line, 6, 10, QChar{'0'})};
+
+                if (!outputFile.open(QFile::OpenModeFlag::WriteOnly | QFile::OpenModeFlag::Truncate) || outputFile.write(record.bytes) != record.bytes.size())
+                    record.errorMessage = QString{"The chart could not be written to '%0'."}.arg(outputFile.fileName());
+            }
+
+            if (record.errorMessage.isEmpty())
+            {
+                rendered.fetch_add(1);
+                bytes.fetch_add(record.bytes.size());
+            }
+            else
+            {
+                failed.fetch_add(1);
+                qWarning().noquote() << QString{"Line %0: %1"}.arg(record.line).arg(record.errorMessage);
+            }
+
+            stageTimes.write.fetch_add(stageTimer.nsecsElapsed());
+            inFlight.release();
+        });
+    }
+
+    for (QFuture<void> &pipeline : pipelines)
+        pipeline.waitForFinished();
+
+    if (report)
+    {
+        report->records    = rendered.load() + failed.load();
+        report->rendered   = rendered.load();
+        report->failed     = failed.load();
+        report->bytes      = bytes.load();
+        report->elapsed    = elapsedTimer.elapsed();
+        report->parseTime  = stageTimes.parse.load()  / 1000000;
+        report->renderTime = stageTimes.render.load() / 1000000;
+        report->encodeTime = stageTimes.encode.load() / 1000000;
+        report->writeTime  = stageTimes.write.load()  / 1000000;
+    }
+
+    return true;
+}
+
+QString BatchRenderer::formatReport(const Report &report)
+{
+    const double seconds {std::max(report.elapsed, qint64{1}) / 1000.0};
+
+    return QString{"Rendered %0 of %1 records (%2 failed) in %3 s: %4 charts/s, %5 MB/s written.\n"
+                   "Busy time per stage: parse %6 ms, render %7 ms, encode %8 ms, write %9 ms."}
+            .arg(report.rendered)
+            .arg(report.records)
+            .arg(report.failed)
+            .arg(seconds, 0, 'f', 2)
+            .arg(report.rendered / seconds, 0, 'f', 1)
+            .arg(report.bytes / seconds / (1024 * 1024), 0, 'f', 2)
+            .arg(report.parseTime)
+            .arg(report.renderTime)
+            .arg(report.encodeTime)
+            .arg(report.writeTime);
+}
@@ -0,0 +1,40 @@
+#ifndef BATCHRENDERER_H
+#define BATCHRENDERER_H
+
+#include <QString>
+
+/* Renders every /line record of a JSONL file into outputDirectory without the
+   HTTP server. Each record runs through a pipeline of parse, render, encode and
+   write stages, every stage has its own thread pool, so different records
+   occupy different stages (and cores) at the same time. */
+
+class BatchRenderer
+{
+public:
+    struct Report
+    {
+        qint64 records  {0};
+        qint64 rendered {0};
+        qint64 failed   {0};
+        qint64 bytes    {0};
+        qint64 elapsed  {0};
+
+        qint64 parseTime  {0};
+        qint64 renderTime {0};
+        qint64 encodeTime {0};
+        qint64 writeTime  {0};
+    };
+
+    BatchRenderer(const QString &outputDirectory, int renderThreads, int compressionLevel = -1);
+
+    bool run(const QString &inputFilename, Report *report) const;
+
+    static QString formatReport(const Report &report);
+
+private:
+    const QString m_outputDirectory;
+    const int     m_renderThreads;
+    const int     m_compressionLevel;
+};
+
+#endif // BATCHRENDERER_H
@@ -0,0 +1,60 @@
+#include "BloomFilter.h"
+
+#include <QHashFunctions>
+
+#include <algorithm>
+#include <cmath>
+
+BloomFilter::BloomFilter(qint64 expectedElements, double falsePositiveRate)
+{
+    const double elements {static_cast<double>(std::max(expectedElements, qint64{1}))};
+    const double rate     {std::clamp(falsePositiveRate, 1e-6, 0.5)};
+
+    //optimal size m = -n ln(p) / ln(2)^2 and hash count k = m / n ln(2)
+    const double bits {std::ceil(-elements * std::log(rate) / (std::log(2.0) * std::log(2.0)))};
+
+    m_bitCount  = std::max<quint64>(static_cast<quint64>(bits), 64);
+    m_hashCount = std::clamp(static_cast<int>(std::round(bits / elements * std::log(2.0))), 1, 16);
+
+    const quint64 wordCount {(m_bitCount + 63) / 64};
+
+    m_words.reset(new std::atomic<quint64>[wordCount]);
+
+    for (quint64 word {0}; word < wordCount; ++word)
+        m_words[word].store(0, std::memory_order_relaxed);
+}
+
+void BloomFilter::insert(const QUuid &uuid)
+{
+    quint64 position {0};
+    quint64 step     {0};
+    bitPositions(uuid, &position, &step);
+
+    for (int hash {0}; hash < m_hashCount; ++hash, position = (position + step) % m_bitCount)
+        m_words[position / 64].fetch_or(quint64{1} << (position % 64), std::memory_order_release);
+}
+
+bool BloomFilter::mightContain(const QUuid &uuid) const
+{
+    quint64 position {0};
+    quint64 step     {0};
+    bitPositions(uuid, &position, &step);
+
+    for (int hash {0}; hash < m_hashCount; ++hash, position = (position + step) % m_bitCount)
+    {
+        if (!(m_words[position / 64].load(std::memory_order_acquire) & (quint64{1} << (position % 64))))
+            return false;
+    }
+
+    return true;
+}
+
+//double hashing: the k positions are first + i * step, from two independently seeded hashes
+void BloomFilter::bitPositions(const QUuid &uuid, quint64 *first, quint64 *step) const
+{
+    const quint64 firstHash  {static_cast<quint64>(qHashBits(&uuid, sizeof(QUuid), 0x9e3779b9))};
+    const quint64 secondHash {static_cast<quint64>(qHashBits(&uuid, sizeof(QUuid), 0x7f4a7c15))};
+
+    *first = firstHash % m_bitCount;
+    *step  = (secondHash % (m_bitCount - 1)) + 1;
+}
@@ -0,0 +1,31 @@
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <QUuid>
+
+#include <memory>
+#include <atomic>
+
+/* Lock-free Bloom filter over UUIDs: mightContain() never misses an inserted
+   UUID and answers "definitely not inserted" for most others. Bits are only
+   ever set, so there is no removal; sized for expectedElements at the given
+   false positive rate, the rate grows once more UUIDs than that were inserted. */
+
+class BloomFilter
+{
+public:
+    explicit BloomFilter(qint64 expectedElements, double falsePositiveRate = 0.01);
+
+    void insert(const QUuid &uuid);
+    bool mightContain(const QUuid &uuid) const;
+
+private:
+    void bitPositions(const QUuid &uuid, quint64 *first, quint64 *step) const;
+
+    quint64 m_bitCount;
+    int     m_hashCount;
+
+    std::unique_ptr<std::atomic<quint64>[]> m_words;
+};
+
+#endif // BLOOMFILTER_H
@@ -0,0 +1,32 @@
+#include "ChartCache.h"
+
+#include <algorithm>
+
+ChartCache::ChartCache(qint64 capacity)
+{
+    setCapacity(capacity);
+}
+
+void ChartCache::setCapacity(qint64 capacity)
+{
+    const QMutexLocker locker {&m_mutex};
+    m_cache.setMaxCost(std::max(capacity, qint64{0}));
+}
+
+void ChartCache::insert(const QUuid &uuid, const QByteArray &bytes)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    if (bytes.size() <= m_cache.maxCost())
+        m_cache.insert(uuid, new QByteArray {bytes}, bytes.size());
+}
+
+QByteArray ChartCache::find(const QUuid &uuid)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    //object() marks the entry as most recently used
+    const QByteArray * const bytes {m_cache.object(uuid)};
+
+    return bytes ? *bytes : QByteArray{};
+}
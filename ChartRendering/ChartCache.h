@@ -0,0 +1,32 @@
+#ifndef CHARTCACHE_H
+#define CHARTCACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QUuid>
+
+/* The memory tier of the chart storage: the PNG bytes of freshly rendered
+   and recently fetched charts, bounded by capacity bytes and evicted least
+   recently used first. It never decides whether a chart exists, callers
+   look it up in the ChartIndex first, so expired charts are never served. */
+
+class ChartCache
+{
+public:
+    explicit ChartCache(qint64 capacity);
+
+    void setCapacity(qint64 capacity);
+
+    //charts larger than the capacity are not cached
+    void insert(const QUuid &uuid, const QByteArray &bytes);
+
+    //a null QByteArray if the chart is not cached
+    QByteArray find(const QUuid &uuid);
+
+private:
+    QMutex m_mutex;
+    QCache<QUuid, QByteArray> m_cache;
+};
+
+#endif // CHARTCACHE_H
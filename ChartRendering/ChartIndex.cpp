@@ -0,0 +1,268 @@
+#include "ChartIndex.h"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QMutexLocker>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QFile>
+
+#include <algorithm>
+
+static constexpr quint32 SNAPSHOT_MAGIC   {0x4C434958};
+static constexpr quint32 SNAPSHOT_VERSION {2};
+
+ChartIndex::ChartIndex(qint64 expectedCharts) :
+    m_expectedCharts {expectedCharts},
+    m_insertedFilter {std::make_shared<BloomFilter>(expectedCharts)}
+{
+
+}
+
+void ChartIndex::insert(const QUuid &uuid, const ChartMetadata &metadata)
+{
+    Stripe &indexStripe {stripe(uuid)};
+
+    const QWriteLocker locker {&indexStripe.lock};
+
+    /* before the entry becomes visible, so mightContain() is never false for a findable UUID;
+       under the stripe lock, so a rebuild either visits the entry or its filter gets the UUID here */
+    std::atomic_load(&m_insertedFilter)->insert(uuid);
+
+    if (const std::shared_ptr<BloomFilter> rebuiltFilter {std::atomic_load(&m_rebuiltFilter)})
+        rebuiltFilter->insert(uuid);
+
+    const auto entry {indexStripe.entries.find(uuid)};
+
+    if (entry != indexStripe.entries.end())
+    {
+        m_totalSize.fetch_add(metadata.size - entry->size);
+        *entry = metadata;
+        return;
+    }
+
+    indexStripe.entries.insert(uuid, metadata);
+
+    m_count.fetch_add(1);
+    m_totalSize.fetch_add(metadata.size);
+}
+
+std::optional<ChartMetadata> ChartIndex::find(const QUuid &uuid) const
+{
+    const Stripe &indexStripe {stripe(uuid)};
+
+    const QReadLocker locker {&indexStripe.lock};
+
+    const auto entry {indexStripe.entries.constFind(uuid)};
+
+    if (entry == indexStripe.entries.constEnd())
+        return std::nullopt;
+
+    return *entry;
+}
+
+std::optional<ChartMetadata> ChartIndex::take(const QUuid &uuid)
+{
+    Stripe &indexStripe {stripe(uuid)};
+
+    const QWriteLocker locker {&indexStripe.lock};
+
+    const auto entry {indexStripe.entries.find(uuid)};
+
+    if (entry == indexStripe.entries.end())
+        return std::nullopt;
+
+    const ChartMetadata metadata {*entry};
+    indexStripe.entries.erase(entry);
+
+    m_count.fetch_sub(1);
+    m_totalSize.fetch_sub(metadata.size);
+
+    return metadata;
+}
+
+bool ChartIndex::replace(const QUuid &uuid, const QString &expectedLocation, const ChartMetadata &metadata)
+{
+    Stripe &indexStripe {stripe(uuid)};
+
+    const QWriteLocker locker {&indexStripe.lock};
+
+    const auto entry {indexStripe.entries.find(uuid)};
+
+    if (entry == indexStripe.entries.end() || entry->location != expectedLocation)
+        return false;
+
+    ChartMetadata replacement {metadata};
+    replacement.created      = entry->created;
+    replacement.lastAccessed = entry->lastAccessed;
+    replacement.accessCount  = entry->accessCount;
+
+    m_totalSize.fetch_add(replacement.size - entry->size);
+    *entry = replacement;
+
+    return true;
+}
+
+void ChartIndex::recordAccess(const QUuid &uuid)
+{
+    Stripe &indexStripe {stripe(uuid)};
+
+    const QWriteLocker locker {&indexStripe.lock};
+
+    const auto entry {indexStripe.entries.find(uuid)};
+
+    if (entry == indexStripe.entries.end())
+        return;
+
+    entry->lastAccessed = QDateTime::currentDateTimeUtc();
+    ++entry->accessCount;
+}
+
+bool ChartIndex::contains(const QUuid &uuid) const
+{
+    const Stripe &indexStripe {stripe(uuid)};
+
+    const QReadLocker locker {&indexStripe.lock};
+    return indexStripe.entries.contains(uuid);
+}
+
+bool ChartIndex::mightContain(const QUuid &uuid) const
+{
+    return std::atomic_load(&m_insertedFilter)->mightContain(uuid);
+}
+
+void ChartIndex::rebuildFilter()
+{
+    const QMutexLocker locker {&m_rebuildMutex};
+
+    const std::shared_ptr<BloomFilter> rebuiltFilter {std::make_shared<BloomFilter>(std::max(m_expectedCharts, 2 * count()))};
+
+    //published before the visit, so entries inserted into already visited stripes are not missed
+    std::atomic_store(&m_rebuiltFilter, rebuiltFilter);
+
+    forEach([&rebuiltFilter](const QUuid &uuid, const ChartMetadata &)
+    {
+        rebuiltFilter->insert(uuid);
+    });
+
+    std::atomic_store(&m_insertedFilter, rebuiltFilter);
+    std::atomic_store(&m_rebuiltFilter, std::shared_ptr<BloomFilter>{});
+}
+
+qint64 ChartIndex::count() const
+{
+    return m_count.load();
+}
+
+qint64 ChartIndex::totalSize() const
+{
+    return m_totalSize.load();
+}
+
+bool ChartIndex::isReady() const
+{
+    return m_ready.load();
+}
+
+void ChartIndex::setReady(bool ready)
+{
+    m_ready.store(ready);
+}
+
+void ChartIndex::forEach(const std::function<void(const QUuid &, const ChartMetadata &)> &visitor) const
+{
+    for (const Stripe &indexStripe : m_stripes)
+    {
+        const QReadLocker locker {&indexStripe.lock};
+
+        for (auto entry {indexStripe.entries.constBegin()}; entry != indexStripe.entries.constEnd(); ++entry)
+            visitor(entry.key(), entry.value());
+    }
+}
+
+bool ChartIndex::save(const QString &filename) const
+{
+    QSaveFile snapshotFile {filename};
+
+    if (!snapshotFile.open(QSaveFile::OpenModeFlag::WriteOnly))
+        return false;
+
+    QDataStream stream {&snapshotFile};
+    stream.setVersion(QDataStream::Version::Qt_6_0);
+
+    stream << SNAPSHOT_MAGIC << SNAPSHOT_VERSION;
+
+    //inserts and removals can run while the stripes are visited, so the count is patched in once the records are written
+    const qint64 countOffset {snapshotFile.pos()};
+    qint64 entries {0};
+
+    stream << entries;
+
+    forEach([&stream, &entries](const QUuid &uuid, const ChartMetadata &metadata)
+    {
+        stream << uuid << metadata.location << metadata.size << metadata.created << metadata.contentHash << metadata.format
+               << metadata.archiveOffset << metadata.lastAccessed << metadata.accessCount;
+
+        ++entries;
+    });
+
+    if (!snapshotFile.seek(countOffset))
+    {
+        snapshotFile.cancelWriting();
+        return false;
+    }
+
+    stream << entries;
+
+    if (stream.status() != QDataStream::Status::Ok)
+    {
+        snapshotFile.cancelWriting();
+        return false;
+    }
+
+    return snapshotFile.commit();
+}
+
+bool ChartIndex::load(const QString &filename)
+{
+    QFile snapshotFile {filename};
+
+    if (!snapshotFile.open(QFile::OpenModeFlag::ReadOnly))
+        return false;
+
+    QDataStream stream {&snapshotFile};
+    stream.setVersion(QDataStream::Version::Qt_6_0);
+
+    quint32 magic   {0};
+    quint32 version {0};
+    qint64  entries {0};
+
+    stream >> magic >> version >> entries;
+
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || entries < 0)
+        return false;
+
+    for (qint64 entry {0}; entry < entries && stream.status() == QDataStream::Status::Ok; ++entry)
+    {
+        QUuid uuid;
+        ChartMetadata metadata;
+
+        stream >> uuid >> metadata.location >> metadata.size >> metadata.created >> metadata.contentHash >> metadata.format
+               >> metadata.archiveOffset >> metadata.lastAccessed >> metadata.accessCount;
+
+        if (stream.status() == QDataStream::Status::Ok)
+            insert(uuid, metadata);
+    }
+
+    return stream.status() == QDataStream::Status::Ok;
+}
+
+ChartIndex::Stripe &ChartIndex::stripe(const QUuid &uuid)
+{
+    return m_stripes[qHash(uuid) % STRIPE_COUNT];
+}
+
+const ChartIndex::Stripe &ChartIndex::stripe(const QUuid &uuid) const
+{
+    return m_stripes[qHash(uuid) % STRIPE_COUNT];
+}
@@ -0,0 +1,107 @@
+#ifndef CHARTINDEX_H
+#define CHARTINDEX_H
+
+#include <QReadWriteLock>
+#include <QMutex>
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+#include <QHash>
+#include <QUuid>
+
+#include <functional>
+#include <optional>
+#include <memory>
+#include <atomic>
+#include <array>
+
+#include "BloomFilter.h"
+
+struct ChartMetadata
+{
+    QString    location;
+    qint64     size {0};
+    QDateTime  created;
+    QByteArray contentHash;
+    QByteArray format;
+
+    //offset of the chart's record in the cold archive segment at location, -1 for a chart file of its own
+    qint64     archiveOffset {-1};
+
+    QDateTime  lastAccessed;
+    int        accessCount {0};
+};
+
+/* Concurrent in-process index from chart UUID to its metadata, so lookups
+   never have to ask the filesystem. Like the JobRegistry it is striped:
+   every stripe is a QHash behind its own QReadWriteLock, readers of
+   different (or the same) stripes never block each other. A Bloom filter
+   over the inserted UUIDs answers most lookups of unknown UUIDs without
+   taking a lock; it only ever fills up, so rebuildFilter() replaces it with
+   one over the current entries. */
+
+class ChartIndex
+{
+public:
+    explicit ChartIndex(qint64 expectedCharts = 1000000);
+
+    void insert(const QUuid &uuid, const ChartMetadata &metadata);
+
+    std::optional<ChartMetadata> find(const QUuid &uuid) const;
+    std::optional<ChartMetadata> take(const QUuid &uuid);
+
+    /* moves an entry to another storage tier: only if it is still stored at expectedLocation,
+       the creation time and the access statistics of the entry are kept */
+    bool replace(const QUuid &uuid, const QString &expectedLocation, const ChartMetadata &metadata);
+
+    void recordAccess(const QUuid &uuid);
+
+    bool contains(const QUuid &uuid) const;
+
+    //false means the UUID was never inserted, true means it may have been
+    bool mightContain(const QUuid &uuid) const;
+
+    //drops the UUIDs which were taken since the last rebuild from the filter, and grows it along with the index
+    void rebuildFilter();
+
+    qint64 count() const;
+    qint64 totalSize() const;
+
+    //false while the index is still being rebuilt from the store
+    bool isReady() const;
+    void setReady(bool ready);
+
+    //visits every entry under the read lock of its stripe, the callback must not modify the index
+    void forEach(const std::function<void(const QUuid &, const ChartMetadata &)> &visitor) const;
+
+    //snapshot of the index for a fast restart without scanning the store
+    bool save(const QString &filename) const;
+    bool load(const QString &filename);
+
+private:
+    struct Stripe
+    {
+        mutable QReadWriteLock      lock;
+        QHash<QUuid, ChartMetadata> entries;
+    };
+
+    static constexpr int STRIPE_COUNT {16};
+
+    Stripe &stripe(const QUuid &uuid);
+    const Stripe &stripe(const QUuid &uuid) const;
+
+    std::array<Stripe, STRIPE_COUNT> m_stripes;
+
+    const qint64 m_expectedCharts;
+
+    //replaced as a whole by rebuildFilter(), while it runs inserts go into both filters
+    std::shared_ptr<BloomFilter> m_insertedFilter;
+    std::shared_ptr<BloomFilter> m_rebuiltFilter;
+    QMutex                       m_rebuildMutex;
+
+    std::atomic<qint64> m_count     {0};
+    std::atomic<qint64> m_totalSize {0};
+    std::atomic<bool>   m_ready     {false};
+};
+
+#endif // CHARTINDEX_H
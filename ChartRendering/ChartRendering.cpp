@@ -0,0 +1,134 @@
+#include "ChartRendering.h"
+
+#include <QElapsedTimer>
+#include <QSemaphore>
+#include <QFuture>
+
+#include <atomic>
+
+namespace
+{
+    constexpr int BandHeight    {128};
+    constexpr int BandsInFlight {3};
+
+    //from here on a single deflate stream is slower than rasterizing, see ParallelPngWriter
+    constexpr qint64 ParallelEncodeThreshold {qint64{2048} * 2048};
+}
+
+bool renderLineChartPng(const QJsonObject &jsonObject, int compressionLevel, QByteArray *bytes, QString *errorMessage)
+{
+    LineChartSpec spec;
+
+    if (!parseLineChartSpec(jsonObject, &spec, errorMessage))
+        return false;
+
+    if (PngEncoder{compressionLevel}.encode(renderLineChart(spec), bytes))
+        return true;
+
+    if (errorMessage)
+        *errorMessage = "The chart could not be encoded.";
+
+    return false;
+}
+
+bool renderLineChartPngStreamed(const LineChartSpec &spec, int compressionLevel, QThreadPool *encodePool, QByteArray *bytes, StageTimings *timings)
+{
+    if (!bytes)
+        return false;
+
+    if (qint64{spec.width} * spec.height >= ParallelEncodeThreshold)
+    {
+        ParallelPngWriter pngWriter {{spec.width, spec.height}, compressionLevel, encodePool, bytes};
+
+        //the chunks are filtered and deflated in parallel, so only the time the render thread spends in the writer is booked
+        QElapsedTimer encodeTimer;
+        qint64 encodeTime {0};
+        qint64 encodeStart {-1};
+
+        const bool rendered
+        {
+            renderLineChartBands(spec, BandHeight, [&pngWriter, &encodeTimer, &encodeTime, &encodeStart](const QImage &band)
+            {
+                if (encodeStart < 0)
+                    encodeStart = StageTimings::currentTime();
+
+                encodeTimer.start();
+                const bool written {pngWriter.writeRows(band)};
+                encodeTime += encodeTimer.nsecsElapsed();
+
+                return written;
+
+            }, timings)
+        };
+
+        encodeTimer.start();
+        const bool finished {rendered && pngWriter.finish()};
+        encodeTime += encodeTimer.nsecsElapsed();
+
+        const qint64 encodeEnd {StageTimings::currentTime()};
+
+        if (timings)
+            timings->add(StageTimings::Stage::Encode, encodeTime, encodeStart < 0 ? encodeEnd - encodeTime : encodeStart, encodeEnd);
+
+        return finished;
+    }
+
+    PngStreamWriter pngWriter {{spec.width, spec.height}, compressionLevel, bytes};
+
+    //bounds the rasterized bands waiting for the encoder
+    QSemaphore bandSlots {BandsInFlight};
+    std::atomic<bool> encoded {true};
+
+    //deflate time of all bands, they are deflated one after another while the render thread hands out the next
+    std::atomic<qint64> encodeTime {0};
+
+    //when the first band was handed to the encoder, the encode span starts there
+    qint64 encodeStart {-1};
+
+    //each band's continuation runs after the previous one, so the rows reach the writer in order
+    QFuture<void> encoding {QtFuture::makeReadyFuture()};
+
+    const bool rendered
+    {
+        renderLineChartBands(spec, BandHeight, [&](const QImage &band)
+        {
+            bandSlots.acquire();
+
+            if (encodeStart < 0)
+                encodeStart = StageTimings::currentTime();
+
+            encoding = encoding.then(encodePool ? encodePool : QThreadPool::globalInstance(), [&pngWriter, &bandSlots, &encoded, &encodeTime, band]() mutable
+            {
+                QElapsedTimer encodeTimer;
+                encodeTimer.start();
+
+                if (encoded.load() && !pngWriter.writeRows(band))
+                    encoded.store(false);
+
+                encodeTime += encodeTimer.nsecsElapsed();
+
+                //the band's buffer goes back to the pool before its slot is handed to the next band
+                band = QImage {};
+                bandSlots.release();
+            });
+
+            return encoded.load();
+
+        }, timings)
+    };
+
+    encoding.waitForFinished();
+
+    QElapsedTimer encodeTimer;
+    encodeTimer.start();
+
+    const bool finished {rendered && encoded.load() && pngWriter.finish()};
+
+    const qint64 totalEncodeTime {encodeTime.load() + encodeTimer.nsecsElapsed()};
+    const qint64 encodeEnd       {StageTimings::currentTime()};
+
+    if (timings)
+        timings->add(StageTimings::Stage::Encode, totalEncodeTime, encodeStart < 0 ? encodeEnd - totalEncodeTime : encodeStart, encodeEnd);
+
+    return finished;
+}
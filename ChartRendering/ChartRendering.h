@@ -0,0 +1,42 @@
+#ifndef CHARTRENDERING_H
+#define CHARTRENDERING_H
+
+/* Public API of the ChartRendering library. Consumers include this header
+   and ChartRendering.pri in their project file:
+
+       LineChartSpec spec;
+       QString errorMessage;
+
+       if (parseLineChartSpec(jsonObject, &spec, &errorMessage))
+           PngEncoder{6}.encode(renderLineChart(spec), &pngBytes);
+
+   renderLineChart() uses QtCharts, which requires a QApplication. */
+
+#include <QThreadPool>
+
+#include "LineChartSpec.h"
+#include "LineChartRenderer.h"
+#include "PngEncoder.h"
+#include "PngStreamWriter.h"
+#include "ParallelPngWriter.h"
+#include "ChartIndex.h"
+#include "ChartStore.h"
+#include "ChartCache.h"
+#include "ColdArchive.h"
+#include "GroupCommit.h"
+#include "ExpiryIndex.h"
+#include "EvictionOrder.h"
+#include "ImageBufferPool.h"
+#include "BatchRenderer.h"
+#include "StageTimings.h"
+
+//parse, render and encode in one call, on failure errorMessage holds the message for the client
+bool renderLineChartPng(const QJsonObject &jsonObject, int compressionLevel, QByteArray *bytes, QString *errorMessage);
+
+/* renders in bands and deflates each band on encodePool while the next one is rasterized,
+   only a few bands are in memory at any time; from 2048x2048 pixels on the bands are
+   deflated in parallel with ParallelPngWriter; if timings is set, the build, layout, raster
+   and encode stages are added to it */
+bool renderLineChartPngStreamed(const LineChartSpec &spec, int compressionLevel, QThreadPool *encodePool, QByteArray *bytes, StageTimings *timings = nullptr);
+
+#endif // CHARTRENDERING_H
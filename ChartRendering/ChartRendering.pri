@@ -0,0 +1,18 @@
+# Links a sibling project (Server, Cli, Benchmark) against the ChartRendering static library.
+
+QT += concurrent charts gui
+
+INCLUDEPATH += $$PWD $$PWD/..
+DEPENDPATH  += $$PWD
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../ChartRendering/release/ -lChartRendering
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../ChartRendering/debug/ -lChartRendering
+else:unix: LIBS += -L$$OUT_PWD/../ChartRendering/ -lChartRendering
+
+include($$PWD/Codecs.pri)
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../ChartRendering/release/libChartRendering.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../ChartRendering/debug/libChartRendering.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../ChartRendering/release/ChartRendering.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../ChartRendering/debug/ChartRendering.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../ChartRendering/libChartRendering.a
@@ -0,0 +1,53 @@
+TEMPLATE = lib
+CONFIG += staticlib c++17
+
+QT = core concurrent gui charts
+
+INCLUDEPATH += $$PWD/..
+
+include(Codecs.pri)
+
+SOURCES += \
+        BatchRenderer.cpp \
+        BloomFilter.cpp \
+        ChartCache.cpp \
+        ChartIndex.cpp \
+        ChartRendering.cpp \
+        ChartStore.cpp \
+        ColdArchive.cpp \
+        EvictionOrder.cpp \
+        ExpiryIndex.cpp \
+        GroupCommit.cpp \
+        ImageBufferPool.cpp \
+        IoUringQueue.cpp \
+        LineChartRenderer.cpp \
+        LineChartSpec.cpp \
+        ParallelPngWriter.cpp \
+        PngEncoder.cpp \
+        PngFormat.cpp \
+        PngStreamWriter.cpp \
+        StageTimings.cpp
+
+HEADERS += \
+    ../CommonUtilities/CommonUtilities.h \
+    BatchRenderer.h \
+    BloomFilter.h \
+    ChartCache.h \
+    ChartIndex.h \
+    ChartRendering.h \
+    ChartStore.h \
+    ColdArchive.h \
+    EvictionOrder.h \
+    ExpiryIndex.h \
+    GroupCommit.h \
+    ImageBufferPool.h \
+    IoUringQueue.h \
+    LineChartRenderer.h \
+    LineChartSpec.h \
+    ParallelPngWriter.h \
+    PngEncoder.h \
+    PngFormat.h \
+    PngStreamWriter.h \
+    Probes.h \
+    StageTimings.h \
+    ZlibBackend.h
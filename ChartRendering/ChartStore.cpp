@@ -0,0 +1,294 @@
+#include "ChartStore.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+
+#include <algorithm>
+#include <cstdio>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "IoUringQueue.h"
+#include "ColdArchive.h"
+
+ChartStore::ChartStore(const QString &directory) :
+    m_directory {directory},
+    m_archive {new ColdArchive {directory + QDir::separator() + "archive"}}
+{
+#ifdef LINECHART_IO_URING
+    m_ioUring.reset(new IoUringQueue {256});
+
+    if (!m_ioUring->isValid())
+        m_ioUring.reset();
+#endif
+}
+
+ChartStore::~ChartStore() = default;
+
+QString ChartStore::directory() const
+{
+    return m_directory;
+}
+
+QString ChartStore::locationFor(const QUuid &uuid, const QByteArray &format) const
+{
+    return m_directory + QDir::separator() + uuid.toString(QUuid::StringFormat::WithoutBraces) + "." + QString{format};
+}
+
+//replaces an existing file at to in one step, so readers see either the old or the new content
+static bool replaceFile(const QString &from, const QString &to)
+{
+#ifdef Q_OS_UNIX
+    return std::rename(QFile::encodeName(from).constData(), QFile::encodeName(to).constData()) == 0;
+#else
+    QFile::remove(to);
+    return QFile::rename(from, to);
+#endif
+}
+
+bool ChartStore::write(const QUuid &uuid, const QByteArray &format, const QByteArray &bytes, ChartMetadata *metadata) const
+{
+    const QString location {locationFor(uuid, format)};
+
+    QFile file {temporaryLocationFor(location)};
+
+    if (!file.open(QFile::OpenModeFlag::WriteOnly | QFile::OpenModeFlag::Truncate))
+        return false;
+
+    if (file.write(bytes) != bytes.size() || !file.flush())
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+
+    file.close();
+
+    if (!replaceFile(file.fileName(), location))
+    {
+        file.remove();
+        return false;
+    }
+
+    if (metadata)
+        *metadata = {location, bytes.size(), QDateTime::currentDateTimeUtc(), contentHash(bytes), format};
+
+    return true;
+}
+
+//one temporary file per write, two renders of the same UUID must not write into each other
+QString ChartStore::temporaryLocationFor(const QString &location) const
+{
+    return QString{"%0.%1.tmp"}.arg(location).arg(m_nextTemporary.fetch_add(1));
+}
+
+bool ChartStore::read(const ChartMetadata &metadata, QByteArray *bytes) const
+{
+    if (metadata.archiveOffset >= 0)
+        return m_archive->read(metadata, bytes);
+
+    QFile file {metadata.location};
+
+    if (!file.open(QFile::OpenModeFlag::ReadOnly))
+        return false;
+
+    if (bytes)
+        *bytes = file.readAll();
+
+    return true;
+}
+
+bool ChartStore::remove(const ChartMetadata &metadata) const
+{
+    //archived charts are removed together with their segment
+    if (metadata.archiveOffset >= 0)
+        return true;
+
+    return QFile::remove(metadata.location);
+}
+
+QFuture<QByteArray> ChartStore::readAsync(const ChartMetadata &metadata) const
+{
+#ifdef LINECHART_IO_URING
+    //archive records are parsed out of their segment, they take the blocking path
+    if (m_ioUring && metadata.archiveOffset < 0)
+        return m_ioUring->read(metadata.location, metadata.size);
+#endif
+
+    return QtConcurrent::run([this, metadata]()
+    {
+        QByteArray bytes;
+        return read(metadata, &bytes) ? bytes : QByteArray{};
+    });
+}
+
+QFuture<ChartMetadata> ChartStore::writeAsync(const QUuid &uuid, const QByteArray &format, const QByteArray &bytes) const
+{
+#ifdef LINECHART_IO_URING
+    if (m_ioUring)
+    {
+        const QString location {locationFor(uuid, format)};
+
+        return m_ioUring->write(temporaryLocationFor(location), location, bytes)
+                .then([location, size = bytes.size(), hash = contentHash(bytes), format](bool written)
+        {
+            return written ? ChartMetadata{location, size, QDateTime::currentDateTimeUtc(), hash, format} : ChartMetadata{};
+        });
+    }
+#endif
+
+    return QtConcurrent::run([this, uuid, format, bytes]()
+    {
+        ChartMetadata metadata;
+        return write(uuid, format, bytes, &metadata) ? metadata : ChartMetadata{};
+    });
+}
+
+QFuture<int> ChartStore::removeAsync(const QVector<ChartMetadata> &metadatas) const
+{
+#ifdef LINECHART_IO_URING
+    if (m_ioUring)
+    {
+        QStringList locations;
+
+        for (const ChartMetadata &metadata : metadatas)
+        {
+            if (metadata.archiveOffset < 0)
+                locations << metadata.location;
+        }
+
+        return m_ioUring->unlink(locations);
+    }
+#endif
+
+    return QtConcurrent::run([this, metadatas]()
+    {
+        return static_cast<int>(std::count_if(metadatas.begin(), metadatas.end(), [this](const ChartMetadata &metadata) { return remove(metadata); }));
+    });
+}
+
+bool ChartStore::usesIoUring() const
+{
+    return !m_ioUring.isNull();
+}
+
+bool ChartStore::archive(const QUuid &uuid, const ChartMetadata &metadata, ChartMetadata *archived) const
+{
+    QByteArray bytes;
+
+    if (!read(metadata, &bytes) || bytes.isEmpty())
+        return false;
+
+    return m_archive->append(uuid, metadata, bytes, archived);
+}
+
+void ChartStore::scanArchive(const std::function<void(const QUuid &, const ChartMetadata &)> &visitor) const
+{
+    m_archive->scan(visitor);
+}
+
+int ChartStore::removeArchiveSegmentsBefore(const QDateTime &cutoff) const
+{
+    return m_archive->removeSegmentsBefore(cutoff);
+}
+
+QHash<QString, qint64> ChartStore::sealedArchiveSegments() const
+{
+    return m_archive->sealedSegments();
+}
+
+bool ChartStore::removeArchiveSegment(const QString &location) const
+{
+    return m_archive->removeSegment(location);
+}
+
+bool ChartStore::flush() const
+{
+#ifdef Q_OS_LINUX
+    //one syncfs() for the whole store instead of one fsync() per chart
+    const int directoryDescriptor {::open(QFile::encodeName(m_directory).constData(), O_RDONLY | O_DIRECTORY)};
+
+    if (directoryDescriptor < 0)
+        return false;
+
+    const bool synced {::syncfs(directoryDescriptor) == 0};
+    ::close(directoryDescriptor);
+
+    return synced;
+#else
+    return true;
+#endif
+}
+
+QStringList ChartStore::scan() const
+{
+    QStringList locations;
+
+    const QDir directory {m_directory};
+
+    for (const QFileInfo &fileInfo : directory.entryInfoList({"*.png", "*.spec"}, QDir::Filter::Files))
+        locations << fileInfo.absoluteFilePath();
+
+    return locations;
+}
+
+int ChartStore::removeTemporaries(const QDateTime &before) const
+{
+    int removed {0};
+
+    const QDir directory {m_directory};
+
+    for (const QFileInfo &fileInfo : directory.entryInfoList({"*.tmp"}, QDir::Filter::Files))
+    {
+        //a write in flight renames its temporary file soon
+        if (fileInfo.lastModified() >= before)
+            continue;
+
+        if (QFile::remove(fileInfo.absoluteFilePath()))
+            ++removed;
+    }
+
+    return removed;
+}
+
+bool ChartStore::describe(const QString &location, QUuid *uuid, ChartMetadata *metadata) const
+{
+    const QFileInfo fileInfo {location};
+    const QUuid fileUuid {QUuid::fromString(fileInfo.completeBaseName())};
+
+    if (fileUuid.isNull())
+        return false;
+
+    QFile file {location};
+
+    if (!file.open(QFile::OpenModeFlag::ReadOnly))
+        return false;
+
+    const QByteArray bytes {file.readAll()};
+
+    //a chart written shortly before a crash can be empty, when its data never reached the disk
+    if (bytes.isEmpty())
+        return false;
+
+    if (uuid)
+        *uuid = fileUuid;
+
+    if (metadata)
+    {
+        const QDateTime birthTime {fileInfo.birthTime()};
+        *metadata = {location, bytes.size(), (birthTime.isValid() ? birthTime : fileInfo.lastModified()).toUTC(), contentHash(bytes), fileInfo.suffix().toUtf8()};
+    }
+
+    return true;
+}
+
+QByteArray ChartStore::contentHash(const QByteArray &bytes)
+{
+    return QCryptographicHash::hash(bytes, QCryptographicHash::Algorithm::Sha1).toHex();
+}
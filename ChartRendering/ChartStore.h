@@ -0,0 +1,81 @@
+#ifndef CHARTSTORE_H
+#define CHARTSTORE_H
+
+#include <QScopedPointer>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <QFuture>
+#include <QString>
+#include <QUuid>
+
+#include <functional>
+#include <atomic>
+
+#include "ChartIndex.h"
+
+class IoUringQueue;
+class ColdArchive;
+
+/* File-backed storage of the rendered charts below imagepath. Charts are
+   written to a temporary file and renamed into place, so a concurrent read
+   never sees a partially written chart. Old charts can be moved into the
+   ColdArchive below imagepath/archive; read() and remove() handle both. */
+
+class ChartStore
+{
+public:
+    explicit ChartStore(const QString &directory);
+    ~ChartStore();
+
+    QString directory() const;
+    QString locationFor(const QUuid &uuid, const QByteArray &format) const;
+
+    bool write(const QUuid &uuid, const QByteArray &format, const QByteArray &bytes, ChartMetadata *metadata) const;
+    bool read(const ChartMetadata &metadata, QByteArray *bytes) const;
+    bool remove(const ChartMetadata &metadata) const;
+
+    /* non-blocking variants: on io_uring when built with CONFIG += io_uring and the kernel supports it,
+       otherwise the blocking calls above on the global thread pool; failures yield a null QByteArray,
+       metadata with an empty location and a smaller count of removed files */
+    QFuture<QByteArray>    readAsync(const ChartMetadata &metadata) const;
+    QFuture<ChartMetadata> writeAsync(const QUuid &uuid, const QByteArray &format, const QByteArray &bytes) const;
+    QFuture<int>           removeAsync(const QVector<ChartMetadata> &metadatas) const;
+
+    bool usesIoUring() const;
+
+    /* appends a chart to the cold archive, the caller removes the chart file or the segment it was read from
+       once the index points to the new record */
+    bool archive(const QUuid &uuid, const ChartMetadata &metadata, ChartMetadata *archived) const;
+    void scanArchive(const std::function<void(const QUuid &, const ChartMetadata &)> &visitor) const;
+    int removeArchiveSegmentsBefore(const QDateTime &cutoff) const;
+
+    //see ColdArchive, to rewrite segments whose records were mostly evicted
+    QHash<QString, qint64> sealedArchiveSegments() const;
+    bool removeArchiveSegment(const QString &location) const;
+
+    //makes everything written so far durable
+    bool flush() const;
+
+    //temporary files left behind by writes that were interrupted by a crash, those of writes started since before are kept
+    int removeTemporaries(const QDateTime &before) const;
+
+    //all chart files currently in the directory, including the specs of lazily rendered charts, used to rebuild the ChartIndex
+    QStringList scan() const;
+    bool describe(const QString &location, QUuid *uuid, ChartMetadata *metadata) const;
+
+    static QByteArray contentHash(const QByteArray &bytes);
+
+private:
+    QString temporaryLocationFor(const QString &location) const;
+
+    const QString m_directory;
+
+    mutable std::atomic<quint64> m_nextTemporary {0};
+
+    QScopedPointer<IoUringQueue> m_ioUring;
+    QScopedPointer<ColdArchive>  m_archive;
+};
+
+#endif // CHARTSTORE_H
@@ -0,0 +1,33 @@
+# Optional native backends of the ChartRendering library, included by the library and its consumers.
+#
+#   zlibng      PngStreamWriter and ParallelPngWriter deflate with zlib-ng instead of the system zlib
+#   libdeflate  PngEncoder defaults to libdeflate instead of QImageWriter
+#   spng        PngEncoder can encode with spng, the default if libdeflate is not built
+#   io_uring    the asynchronous ChartStore calls use io_uring (liburing, Linux 5.11) where the kernel allows it
+#   usdt        USDT probes at the stage boundaries of the server (sys/sdt.h), see Probes.h
+
+zlibng {
+    DEFINES += LINECHART_ZLIBNG
+    LIBS    += -lz-ng
+} else {
+    LIBS    += -lz
+}
+
+libdeflate {
+    DEFINES += LINECHART_LIBDEFLATE
+    LIBS    += -ldeflate
+}
+
+spng {
+    DEFINES += LINECHART_SPNG
+    LIBS    += -lspng
+}
+
+linux:io_uring {
+    DEFINES += LINECHART_IO_URING
+    LIBS    += -luring
+}
+
+usdt {
+    DEFINES += LINECHART_USDT
+}
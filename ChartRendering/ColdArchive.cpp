@@ -0,0 +1,200 @@
+#include "ColdArchive.h"
+
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDir>
+
+//records of the first format are always compressed, since the second one a flag tells
+static constexpr quint32 RECORD_MAGIC            {0x4C434152};
+static constexpr quint32 RECORD_MAGIC_COMPRESSED {0x4C434153};
+
+namespace
+{
+    //reads the record at the position of stream, payload is the stored and maybe compressed chart
+    bool readRecord(QDataStream &stream, QUuid *uuid, ChartMetadata *metadata, QByteArray *payload, bool *compressed)
+    {
+        quint32 magic {0};
+        stream >> magic >> *uuid >> metadata->format >> metadata->created >> metadata->contentHash;
+
+        *compressed = true;
+
+        if (magic == RECORD_MAGIC_COMPRESSED)
+            stream >> *compressed;
+        else if (magic != RECORD_MAGIC)
+            return false;
+
+        stream >> *payload;
+
+        return stream.status() == QDataStream::Status::Ok;
+    }
+}
+
+ColdArchive::ColdArchive(const QString &directory, qint64 segmentSize) :
+    m_directory {directory},
+    m_segmentSize {segmentSize}
+{
+
+}
+
+bool ColdArchive::append(const QUuid &uuid, const ChartMetadata &metadata, const QByteArray &bytes, ChartMetadata *archived)
+{
+    //deflating a PNG again costs a lot and saves next to nothing
+    const bool compressed {metadata.format != "png"};
+
+    QByteArray record;
+
+    QDataStream recordStream {&record, QDataStream::OpenModeFlag::WriteOnly};
+    recordStream.setVersion(QDataStream::Version::Qt_6_0);
+    recordStream << RECORD_MAGIC_COMPRESSED << uuid << metadata.format << metadata.created << metadata.contentHash
+                 << compressed << (compressed ? qCompress(bytes) : bytes);
+
+    const QMutexLocker locker {&m_mutex};
+
+    if ((!m_segment.isOpen() || m_segment.size() >= m_segmentSize) && !openSegment())
+        return false;
+
+    const qint64 offset {m_segment.size()};
+
+    //a partially written record is cut off again, so the segment stays readable for scan()
+    if (m_segment.write(record) != record.size() || !m_segment.flush())
+    {
+        m_segment.resize(offset);
+        return false;
+    }
+
+    if (archived)
+        *archived = {m_segment.fileName(), record.size(), metadata.created, metadata.contentHash, metadata.format, offset};
+
+    return true;
+}
+
+bool ColdArchive::read(const ChartMetadata &metadata, QByteArray *bytes) const
+{
+    QFile segmentFile {metadata.location};
+
+    if (!segmentFile.open(QFile::OpenModeFlag::ReadOnly) || !segmentFile.seek(metadata.archiveOffset))
+        return false;
+
+    const QByteArray record {segmentFile.read(metadata.size)};
+
+    QDataStream recordStream {record};
+    recordStream.setVersion(QDataStream::Version::Qt_6_0);
+
+    QUuid         uuid;
+    ChartMetadata recordMetadata;
+    QByteArray    payload;
+    bool          compressed {true};
+
+    if (!readRecord(recordStream, &uuid, &recordMetadata, &payload, &compressed))
+        return false;
+
+    const QByteArray chartBytes {compressed ? qUncompress(payload) : payload};
+
+    if (chartBytes.isEmpty())
+        return false;
+
+    if (bytes)
+        *bytes = chartBytes;
+
+    return true;
+}
+
+void ColdArchive::scan(const std::function<void(const QUuid &, const ChartMetadata &)> &visitor) const
+{
+    const QDir directory {m_directory};
+
+    for (const QFileInfo &fileInfo : directory.entryInfoList({"*.segment"}, QDir::Filter::Files, QDir::SortFlag::Name))
+    {
+        QFile segmentFile {fileInfo.absoluteFilePath()};
+
+        if (!segmentFile.open(QFile::OpenModeFlag::ReadOnly))
+            continue;
+
+        QDataStream segmentStream {&segmentFile};
+        segmentStream.setVersion(QDataStream::Version::Qt_6_0);
+
+        while (!segmentStream.atEnd())
+        {
+            const qint64 offset {segmentFile.pos()};
+
+            QUuid         uuid;
+            ChartMetadata metadata;
+            QByteArray    payload;
+            bool          compressed {true};
+
+            if (!readRecord(segmentStream, &uuid, &metadata, &payload, &compressed))
+                break;
+
+            metadata.location      = fileInfo.absoluteFilePath();
+            metadata.size          = segmentFile.pos() - offset;
+            metadata.archiveOffset = offset;
+
+            visitor(uuid, metadata);
+        }
+    }
+}
+
+int ColdArchive::removeSegmentsBefore(const QDateTime &cutoff)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    int removed {0};
+
+    const QDir directory {m_directory};
+
+    for (const QFileInfo &fileInfo : directory.entryInfoList({"*.segment"}, QDir::Filter::Files))
+    {
+        if (fileInfo.absoluteFilePath() == QFileInfo{m_segment.fileName()}.absoluteFilePath() || fileInfo.lastModified() >= cutoff)
+            continue;
+
+        if (QFile::remove(fileInfo.absoluteFilePath()))
+            ++removed;
+    }
+
+    return removed;
+}
+
+QHash<QString, qint64> ColdArchive::sealedSegments() const
+{
+    const QMutexLocker locker {&m_mutex};
+
+    QHash<QString, qint64> segments;
+
+    const QDir directory {m_directory};
+
+    for (const QFileInfo &fileInfo : directory.entryInfoList({"*.segment"}, QDir::Filter::Files))
+    {
+        if (fileInfo.absoluteFilePath() != QFileInfo{m_segment.fileName()}.absoluteFilePath())
+            segments.insert(fileInfo.absoluteFilePath(), fileInfo.size());
+    }
+
+    return segments;
+}
+
+bool ColdArchive::removeSegment(const QString &location)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    if (QFileInfo{location}.absoluteFilePath() == QFileInfo{m_segment.fileName()}.absoluteFilePath())
+        return false;
+
+    return QFile::remove(location);
+}
+
+bool ColdArchive::openSegment()
+{
+    m_segment.close();
+
+    if (!QDir{}.mkpath(m_directory))
+        return false;
+
+    //named by their creation, so scan() visits older segments first
+    QString filename;
+
+    for (int attempt {0}; filename.isEmpty() || QFile::exists(filename); ++attempt)
+        filename = m_directory + QDir::separator() + QString{"%0-%1.segment"}.arg(QDateTime::currentMSecsSinceEpoch(), 13, 10, QChar{'0'}).arg(attempt);
+
+    m_segment.setFileName(filename);
+
+    return m_segment.open(QFile::OpenModeFlag::WriteOnly | QFile::OpenModeFlag::Append);
+}
@@ -0,0 +1,56 @@
+#ifndef COLDARCHIVE_H
+#define COLDARCHIVE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+#include <QMutex>
+#include <QFile>
+#include <QHash>
+#include <QUuid>
+
+#include <functional>
+
+#include "ChartIndex.h"
+
+/* The cold tier of the chart storage: old charts are packed as records
+   into append-only segment files below archive/, so the warm tier does not
+   keep one file per rarely fetched chart. PNGs are stored as they are, they
+   are deflated already; other formats are zlib compressed. Records are never
+   removed one by one, a segment is deleted as a whole once every chart in
+   it has expired, or rewritten by the caller once most of it is dead. */
+
+class ColdArchive
+{
+public:
+    explicit ColdArchive(const QString &directory, qint64 segmentSize = DefaultSegmentSize);
+
+    //on success archived locates the record, metadata of the chart is carried over
+    bool append(const QUuid &uuid, const ChartMetadata &metadata, const QByteArray &bytes, ChartMetadata *archived);
+    bool read(const ChartMetadata &metadata, QByteArray *bytes) const;
+
+    //every complete record of every segment, used to rebuild the ChartIndex
+    void scan(const std::function<void(const QUuid &, const ChartMetadata &)> &visitor) const;
+
+    //a segment last appended to before cutoff only holds charts created before cutoff
+    int removeSegmentsBefore(const QDateTime &cutoff);
+
+    //the size of every segment which is no longer appended to, keyed by its absolute path
+    QHash<QString, qint64> sealedSegments() const;
+
+    //deletes a sealed segment whose live records were appended elsewhere
+    bool removeSegment(const QString &location);
+
+    static constexpr qint64 DefaultSegmentSize {64 * 1024 * 1024};
+
+private:
+    bool openSegment();
+
+    const QString m_directory;
+    const qint64  m_segmentSize;
+
+    mutable QMutex m_mutex;
+    QFile          m_segment;
+};
+
+#endif // COLDARCHIVE_H
@@ -0,0 +1,88 @@
+#include "EvictionOrder.h"
+
+#include <QMutexLocker>
+
+EvictionOrder::EvictionOrder(Policy policy) :
+    m_policy {policy}
+{
+
+}
+
+EvictionOrder::Policy EvictionOrder::policy() const
+{
+    return m_policy;
+}
+
+void EvictionOrder::insert(const QUuid &uuid, const QDateTime &created)
+{
+    const qint64 rank {created.toMSecsSinceEpoch()};
+
+    const QMutexLocker locker {&m_mutex};
+
+    const auto existing {m_ranks.constFind(uuid)};
+
+    if (existing != m_ranks.constEnd())
+        m_order.remove(existing.value(), uuid);
+
+    m_ranks.insert(uuid, rank);
+    m_order.insert(rank, uuid);
+}
+
+void EvictionOrder::remove(const QUuid &uuid)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    const auto rank {m_ranks.constFind(uuid)};
+
+    if (rank == m_ranks.constEnd())
+        return;
+
+    m_order.remove(rank.value(), uuid);
+    m_ranks.erase(rank);
+}
+
+void EvictionOrder::touch(const QUuid &uuid)
+{
+    if (m_policy != Policy::LeastRecentlyFetched)
+        return;
+
+    const qint64 now {QDateTime::currentMSecsSinceEpoch()};
+
+    const QMutexLocker locker {&m_mutex};
+
+    const auto rank {m_ranks.find(uuid)};
+
+    if (rank == m_ranks.end())
+        return;
+
+    m_order.remove(rank.value(), uuid);
+    m_order.insert(now, uuid);
+    *rank = now;
+}
+
+std::optional<QUuid> EvictionOrder::takeFirst()
+{
+    const QMutexLocker locker {&m_mutex};
+
+    if (m_order.isEmpty())
+        return std::nullopt;
+
+    const auto first {m_order.begin()};
+    const QUuid uuid {first.value()};
+
+    m_order.erase(first);
+    m_ranks.remove(uuid);
+
+    return uuid;
+}
+
+std::optional<EvictionOrder::Policy> EvictionOrder::policyFromName(const QString &name)
+{
+    if (name == "oldest")
+        return Policy::OldestFirst;
+
+    if (name == "lru")
+        return Policy::LeastRecentlyFetched;
+
+    return std::nullopt;
+}
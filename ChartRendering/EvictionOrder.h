@@ -0,0 +1,50 @@
+#ifndef EVICTIONORDER_H
+#define EVICTIONORDER_H
+
+#include <QMultiMap>
+#include <QDateTime>
+#include <QString>
+#include <QMutex>
+#include <QHash>
+#include <QUuid>
+
+#include <optional>
+
+/* The order in which charts leave the store once it exceeds its byte budget:
+   oldest created first, or least recently fetched first. Both keep every chart
+   under a timestamp, creation time or time of the last fetch, so the next
+   victim is always the first entry and no directory has to be scanned. */
+
+class EvictionOrder
+{
+public:
+    enum class Policy
+    {
+        OldestFirst,
+        LeastRecentlyFetched
+    };
+
+    explicit EvictionOrder(Policy policy);
+
+    Policy policy() const;
+
+    void insert(const QUuid &uuid, const QDateTime &created);
+    void remove(const QUuid &uuid);
+
+    //a fetch of the chart, only moves it back in the order with LeastRecentlyFetched
+    void touch(const QUuid &uuid);
+
+    std::optional<QUuid> takeFirst();
+
+    //"oldest" or "lru"
+    static std::optional<Policy> policyFromName(const QString &name);
+
+private:
+    const Policy m_policy;
+
+    QMutex                   m_mutex;
+    QMultiMap<qint64, QUuid> m_order;
+    QHash<QUuid, qint64>     m_ranks;
+};
+
+#endif // EVICTIONORDER_H
@@ -0,0 +1,34 @@
+#include "ExpiryIndex.h"
+
+#include <QMutexLocker>
+
+void ExpiryIndex::insert(const QUuid &uuid, const QDateTime &created)
+{
+    const QMutexLocker locker {&m_mutex};
+    m_entries.insert(created.toMSecsSinceEpoch(), uuid);
+}
+
+void ExpiryIndex::remove(const QUuid &uuid, const QDateTime &created)
+{
+    const QMutexLocker locker {&m_mutex};
+    m_entries.remove(created.toMSecsSinceEpoch(), uuid);
+}
+
+QVector<QUuid> ExpiryIndex::takeExpired(const QDateTime &cutoff)
+{
+    const qint64 cutoffMSecs {cutoff.toMSecsSinceEpoch()};
+
+    QVector<QUuid> expired;
+
+    const QMutexLocker locker {&m_mutex};
+
+    auto entry {m_entries.begin()};
+
+    while (entry != m_entries.end() && entry.key() < cutoffMSecs)
+    {
+        expired << entry.value();
+        entry = m_entries.erase(entry);
+    }
+
+    return expired;
+}
@@ -0,0 +1,25 @@
+#ifndef EXPIRYINDEX_H
+#define EXPIRYINDEX_H
+
+#include <QMultiMap>
+#include <QDateTime>
+#include <QVector>
+#include <QMutex>
+#include <QUuid>
+
+//charts ordered by creation time, so the expiry sweep only touches what actually expired
+
+class ExpiryIndex
+{
+public:
+    void insert(const QUuid &uuid, const QDateTime &created);
+    void remove(const QUuid &uuid, const QDateTime &created);
+
+    QVector<QUuid> takeExpired(const QDateTime &cutoff);
+
+private:
+    mutable QMutex           m_mutex;
+    QMultiMap<qint64, QUuid> m_entries;
+};
+
+#endif // EXPIRYINDEX_H
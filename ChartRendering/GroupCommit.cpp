@@ -0,0 +1,90 @@
+#include "GroupCommit.h"
+
+#include <QDeadlineTimer>
+
+#include <algorithm>
+
+GroupCommit::GroupCommit(const ChartStore *store, int interval) :
+    m_store {store},
+    m_interval {std::max(interval, 0)},
+    m_thread {QThread::create([this]() { run(); })}
+{
+    m_thread->start();
+}
+
+GroupCommit::~GroupCommit()
+{
+    {
+        const QMutexLocker locker {&m_mutex};
+        m_stopping = true;
+    }
+
+    m_changed.wakeAll();
+    m_thread->wait();
+}
+
+void GroupCommit::setInterval(int interval)
+{
+    const QMutexLocker locker {&m_mutex};
+    m_interval = std::max(interval, 0);
+}
+
+QFuture<bool> GroupCommit::commit()
+{
+    QPromise<bool> promise;
+    promise.start();
+
+    QFuture<bool> future {promise.future()};
+
+    {
+        const QMutexLocker locker {&m_mutex};
+
+        if (!m_stopping)
+        {
+            m_waiting.push_back(std::move(promise));
+            m_changed.wakeAll();
+
+            return future;
+        }
+    }
+
+    promise.addResult(m_store->flush());
+    promise.finish();
+
+    return future;
+}
+
+void GroupCommit::run()
+{
+    QMutexLocker locker {&m_mutex};
+
+    while (true)
+    {
+        while (m_waiting.empty() && !m_stopping)
+            m_changed.wait(&m_mutex);
+
+        if (m_waiting.empty())
+            return;
+
+        //the first commit opens the group, everything that arrives within the interval joins it
+        const QDeadlineTimer deadline {m_interval};
+
+        while (!m_stopping && !deadline.hasExpired())
+            m_changed.wait(&m_mutex, deadline);
+
+        std::vector<QPromise<bool> > group;
+        group.swap(m_waiting);
+
+        locker.unlock();
+
+        const bool flushed {m_store->flush()};
+
+        for (QPromise<bool> &promise : group)
+        {
+            promise.addResult(flushed);
+            promise.finish();
+        }
+
+        locker.relock();
+    }
+}
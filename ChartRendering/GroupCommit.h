@@ -0,0 +1,47 @@
+#ifndef GROUPCOMMIT_H
+#define GROUPCOMMIT_H
+
+#include <QScopedPointer>
+#include <QWaitCondition>
+#include <QPromise>
+#include <QFuture>
+#include <QThread>
+#include <QMutex>
+
+#include <vector>
+
+#include "ChartStore.h"
+
+/* Makes chart writes durable in groups: commit() requests are collected for
+   up to interval milliseconds, then a single ChartStore::flush() covers all of
+   them and resolves their futures with its result. Durability costs one
+   syncfs() per interval instead of one fsync() per chart. */
+
+class GroupCommit
+{
+public:
+    GroupCommit(const ChartStore *store, int interval);
+    ~GroupCommit();
+
+    void setInterval(int interval);
+
+    //true once everything written before the call is durable
+    QFuture<bool> commit();
+
+private:
+    void run();
+
+    const ChartStore * const m_store;
+
+    QMutex         m_mutex;
+    QWaitCondition m_changed;
+
+    std::vector<QPromise<bool> > m_waiting;
+
+    int  m_interval;
+    bool m_stopping {false};
+
+    QScopedPointer<QThread> m_thread;
+};
+
+#endif // GROUPCOMMIT_H
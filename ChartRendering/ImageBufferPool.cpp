@@ -0,0 +1,175 @@
+#include "ImageBufferPool.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr int BucketGranularity {256};
+}
+
+Q_GLOBAL_STATIC_WITH_ARGS(ImageBufferPool, globalImageBufferPool, (ImageBufferPool::DefaultMaxFreeBytes, ImageBufferPool::DefaultMaxBufferBytes))
+
+ImageBufferPool::ImageBufferPool(qint64 maxFreeBytes, qint64 maxBufferBytes) :
+    m_maxFreeBytes   {std::max(maxFreeBytes, qint64{0})},
+    m_maxBufferBytes {std::max(maxBufferBytes, qint64{0})}
+{
+
+}
+
+ImageBufferPool::~ImageBufferPool()
+{
+    qDeleteAll(m_releaseOrder);
+}
+
+QImage ImageBufferPool::acquire(const QSize &size, QRgb fillColor)
+{
+    if (size.isEmpty())
+        return {};
+
+    const QSize   bucket    {bucketSize(size)};
+    const quint64 bucketKey {(quint64(bucket.width()) << 32) | quint64(bucket.height())};
+    const qint64  bytes     {qint64{bucket.width()} * bucket.height() * 4};
+
+    Buffer *buffer {nullptr};
+
+    {
+        const QMutexLocker locker {&m_mutex};
+
+        //too large to be kept around, an ordinary image
+        if (bytes > m_maxBufferBytes)
+        {
+            QImage image {size, BufferFormat};
+
+            if (!image.isNull())
+                image.fill(fillColor);
+
+            return image;
+        }
+
+        const auto freeBuffers {m_freeBuffers.find(bucketKey)};
+
+        if (freeBuffers != m_freeBuffers.end() && !freeBuffers->isEmpty())
+        {
+            buffer = freeBuffers->takeLast();
+
+            m_releaseOrder.removeOne(buffer);
+            m_freeBytes -= buffer->image.sizeInBytes();
+        }
+    }
+
+    if (!buffer)
+    {
+        buffer = new Buffer {this, bucketKey, QImage {bucket, BufferFormat}};
+
+        if (buffer->image.isNull())
+        {
+            delete buffer;
+            return {};
+        }
+
+        m_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //a view with the requested size on the bucket's buffer, the cleanup function hands the buffer back
+    QImage image {buffer->image.bits(), size.width(), size.height(), buffer->image.bytesPerLine(), BufferFormat, &ImageBufferPool::recycle, buffer};
+
+    //QImage::fill() ends up in qt_memfill, which is vectorized
+    image.fill(fillColor);
+
+    return image;
+}
+
+void ImageBufferPool::setLimits(qint64 maxFreeBytes, qint64 maxBufferBytes)
+{
+    QVector<Buffer *> evicted;
+
+    {
+        const QMutexLocker locker {&m_mutex};
+
+        m_maxFreeBytes   = std::max(maxFreeBytes, qint64{0});
+        m_maxBufferBytes = std::max(maxBufferBytes, qint64{0});
+
+        evicted = evict();
+    }
+
+    qDeleteAll(evicted);
+}
+
+qint64 ImageBufferPool::allocations() const
+{
+    return m_allocations.load(std::memory_order_relaxed);
+}
+
+qint64 ImageBufferPool::freeBytes() const
+{
+    const QMutexLocker locker {&m_mutex};
+    return m_freeBytes;
+}
+
+ImageBufferPool *ImageBufferPool::globalInstance()
+{
+    return globalImageBufferPool();
+}
+
+void ImageBufferPool::recycle(void *info)
+{
+    Buffer * const buffer {static_cast<Buffer *>(info)};
+    buffer->pool->release(buffer);
+}
+
+QSize ImageBufferPool::bucketSize(const QSize &size)
+{
+    const auto roundUp = [](int length)
+    {
+        return std::max((length + BucketGranularity - 1) / BucketGranularity, 1) * BucketGranularity;
+    };
+
+    return {roundUp(size.width()), roundUp(size.height())};
+}
+
+void ImageBufferPool::release(Buffer *buffer)
+{
+    QVector<Buffer *> evicted;
+
+    {
+        const QMutexLocker locker {&m_mutex};
+
+        //more than the pool may keep, e.g. after the limits were lowered while the buffer was out
+        if (buffer->image.sizeInBytes() > std::min(m_maxBufferBytes, m_maxFreeBytes))
+        {
+            evicted << buffer;
+        }
+        else
+        {
+            m_freeBuffers[buffer->bucket] << buffer;
+            m_releaseOrder << buffer;
+            m_freeBytes += buffer->image.sizeInBytes();
+
+            evicted = evict();
+        }
+    }
+
+    //freeing large buffers takes a while, not under the lock
+    qDeleteAll(evicted);
+}
+
+QVector<ImageBufferPool::Buffer *> ImageBufferPool::evict()
+{
+    QVector<Buffer *> evicted;
+
+    while (m_freeBytes > m_maxFreeBytes && !m_releaseOrder.isEmpty())
+    {
+        Buffer * const buffer {m_releaseOrder.takeFirst()};
+
+        QVector<Buffer *> &freeBuffers {m_freeBuffers[buffer->bucket]};
+        freeBuffers.removeOne(buffer);
+
+        if (freeBuffers.isEmpty())
+            m_freeBuffers.remove(buffer->bucket);
+
+        m_freeBytes -= buffer->image.sizeInBytes();
+        evicted << buffer;
+    }
+
+    return evicted;
+}
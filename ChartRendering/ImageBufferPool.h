@@ -0,0 +1,72 @@
+#ifndef IMAGEBUFFERPOOL_H
+#define IMAGEBUFFERPOOL_H
+
+#include <QImage>
+#include <QMutex>
+#include <QVector>
+#include <QHash>
+#include <QSize>
+
+#include <atomic>
+
+/* Recycles the pixel buffers of render targets. Buffers are bucketed by size,
+   rounded up to multiples of 256 pixels, so nearby output sizes share a bucket.
+   acquire() returns an ordinary QImage on a pooled buffer; when the last copy
+   of that image is destroyed, the buffer goes back to its bucket instead of
+   being freed. The free buffers are limited to maxFreeBytes in total, beyond
+   that the least recently released ones are freed; images of more than
+   maxBufferBytes are not pooled at all. The pool must outlive every image it
+   handed out. */
+
+class ImageBufferPool
+{
+public:
+    ImageBufferPool(qint64 maxFreeBytes, qint64 maxBufferBytes);
+    ~ImageBufferPool();
+
+    //cleared to fillColor, a null image if the buffer could not be allocated
+    QImage acquire(const QSize &size, QRgb fillColor = 0xffffffff);
+
+    //frees the least recently released buffers right away, if the free ones exceed maxFreeBytes
+    void setLimits(qint64 maxFreeBytes, qint64 maxBufferBytes);
+
+    qint64 allocations() const;
+    qint64 freeBytes() const;
+
+    static ImageBufferPool *globalInstance();
+
+    static constexpr QImage::Format BufferFormat {QImage::Format_RGB32};
+
+    static constexpr qint64 DefaultMaxFreeBytes   {qint64{256} * 1024 * 1024};
+    static constexpr qint64 DefaultMaxBufferBytes {qint64{64} * 1024 * 1024};
+
+private:
+    struct Buffer
+    {
+        ImageBufferPool *pool;
+        quint64          bucket;
+        QImage           image;
+    };
+
+    static void recycle(void *info);
+    static QSize bucketSize(const QSize &size);
+
+    void release(Buffer *buffer);
+
+    //the caller holds m_mutex, returns the buffers to delete once it released it
+    QVector<Buffer *> evict();
+
+    mutable QMutex m_mutex;
+    QHash<quint64, QVector<Buffer *> > m_freeBuffers;
+
+    //every free buffer, least recently released first
+    QVector<Buffer *> m_releaseOrder;
+
+    qint64 m_freeBytes      {0};
+    qint64 m_maxFreeBytes   {0};
+    qint64 m_maxBufferBytes {0};
+
+    std::atomic<qint64> m_allocations {0};
+};
+
+#endif // IMAGEBUFFERPOOL_H
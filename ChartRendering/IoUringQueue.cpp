@@ -0,0 +1,383 @@
+#include "IoUringQueue.h"
+
+#ifdef LINECHART_IO_URING
+
+#include <QStringList>
+#include <QVector>
+#include <QThread>
+#include <QDebug>
+#include <QFile>
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <cerrno>
+
+namespace
+{
+    //io_uring_submit() fails with -EAGAIN while the kernel is short of memory for the requests
+    constexpr int SubmitRetries {100};
+}
+
+//the completion ring has twice the entries of the submission ring, one request per operation fits both
+IoUringQueue::IoUringQueue(unsigned entries) :
+    m_capacity {std::max(entries, 1u)}
+{
+    if (io_uring_queue_init(entries, &m_ring, 0) < 0)
+        return;
+
+    io_uring_probe * const probe {io_uring_get_probe_ring(&m_ring)};
+
+    const bool supported {probe &&
+                          io_uring_opcode_supported(probe, IORING_OP_OPENAT) &&
+                          io_uring_opcode_supported(probe, IORING_OP_READ) &&
+                          io_uring_opcode_supported(probe, IORING_OP_WRITE) &&
+                          io_uring_opcode_supported(probe, IORING_OP_CLOSE) &&
+                          io_uring_opcode_supported(probe, IORING_OP_RENAMEAT) &&
+                          io_uring_opcode_supported(probe, IORING_OP_UNLINKAT)};
+
+    if (probe)
+        io_uring_free_probe(probe);
+
+    if (!supported)
+    {
+        io_uring_queue_exit(&m_ring);
+        return;
+    }
+
+    m_valid = true;
+
+    m_completionThread.reset(QThread::create([this]() { run(); }));
+    m_completionThread->start();
+}
+
+IoUringQueue::~IoUringQueue()
+{
+    if (!m_valid)
+        return;
+
+    Operation * const stop {new Operation};
+    stop->step = Operation::Step::Stop;
+
+    start({stop});
+
+    m_completionThread->wait();
+    io_uring_queue_exit(&m_ring);
+}
+
+bool IoUringQueue::isValid() const
+{
+    return m_valid;
+}
+
+QFuture<QByteArray> IoUringQueue::read(const QString &path, qint64 size)
+{
+    Operation * const operation {new Operation};
+    operation->path   = QFile::encodeName(path);
+    operation->buffer = QByteArray {static_cast<qsizetype>(size), Qt::Initialization::Uninitialized};
+
+    operation->readPromise.start();
+    const QFuture<QByteArray> future {operation->readPromise.future()};
+
+    m_inFlight.fetch_add(1);
+    start({operation});
+
+    return future;
+}
+
+QFuture<bool> IoUringQueue::write(const QString &temporaryPath, const QString &path, const QByteArray &bytes)
+{
+    Operation * const operation {new Operation};
+    operation->path       = QFile::encodeName(temporaryPath);
+    operation->targetPath = QFile::encodeName(path);
+    operation->buffer     = bytes;
+    operation->writing    = true;
+
+    operation->writePromise.start();
+    const QFuture<bool> future {operation->writePromise.future()};
+
+    m_inFlight.fetch_add(1);
+    start({operation});
+
+    return future;
+}
+
+QFuture<int> IoUringQueue::unlink(const QStringList &paths)
+{
+    const std::shared_ptr<UnlinkBatch> batch {std::make_shared<UnlinkBatch>()};
+    batch->remaining = paths.size();
+
+    batch->promise.start();
+    const QFuture<int> future {batch->promise.future()};
+
+    if (paths.isEmpty())
+    {
+        batch->promise.addResult(0);
+        batch->promise.finish();
+
+        return future;
+    }
+
+    m_inFlight.fetch_add(1);
+
+    QVector<Operation *> operations;
+    operations.reserve(paths.size());
+
+    for (const QString &path : paths)
+    {
+        Operation * const operation {new Operation};
+        operation->step  = Operation::Step::Unlink;
+        operation->path  = QFile::encodeName(path);
+        operation->batch = batch;
+
+        operations << operation;
+    }
+
+    start(operations);
+
+    return future;
+}
+
+void IoUringQueue::start(const QVector<Operation *> &operations)
+{
+    const QMutexLocker locker {&m_submitMutex};
+
+    bool prepared {false};
+
+    for (Operation * const operation : operations)
+    {
+        if (m_running >= m_capacity)
+        {
+            m_queued.push_back(operation);
+            continue;
+        }
+
+        ++m_running;
+        prepare(operation);
+        prepared = true;
+    }
+
+    if (prepared)
+        submitPrepared();
+}
+
+void IoUringQueue::submit(Operation *operation)
+{
+    const QMutexLocker locker {&m_submitMutex};
+
+    prepare(operation);
+    submitPrepared();
+}
+
+void IoUringQueue::release()
+{
+    const QMutexLocker locker {&m_submitMutex};
+
+    if (m_queued.empty())
+    {
+        --m_running;
+        return;
+    }
+
+    //the slot goes straight to the next operation
+    Operation * const operation {m_queued.front()};
+    m_queued.pop_front();
+
+    prepare(operation);
+    submitPrepared();
+}
+
+void IoUringQueue::submitPrepared()
+{
+    int submitted {io_uring_submit(&m_ring)};
+
+    for (int retry {0}; (submitted == -EINTR || submitted == -EAGAIN) && retry < SubmitRetries; ++retry)
+    {
+        QThread::yieldCurrentThread();
+        submitted = io_uring_submit(&m_ring);
+    }
+
+    //the entries stay in the submission ring and go out with the next submission
+    if (submitted < 0)
+        qWarning() << "io_uring_submit failed with error" << -submitted;
+}
+
+void IoUringQueue::prepare(Operation *operation)
+{
+    //at most m_capacity operations run, each with one request, and every prepared request is submitted right away
+    io_uring_sqe * const sqe {io_uring_get_sqe(&m_ring)};
+    Q_ASSERT(sqe);
+
+    switch (operation->step)
+    {
+    case Operation::Step::Open:
+        io_uring_prep_openat(sqe, AT_FDCWD, operation->path.constData(),
+                             operation->writing ? O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC : O_RDONLY | O_CLOEXEC, 0644);
+        break;
+
+    case Operation::Step::Read:
+        io_uring_prep_read(sqe, operation->descriptor, operation->buffer.data() + operation->transferred,
+                           static_cast<unsigned>(operation->buffer.size() - operation->transferred), static_cast<__u64>(operation->transferred));
+        break;
+
+    case Operation::Step::Write:
+        io_uring_prep_write(sqe, operation->descriptor, operation->buffer.constData() + operation->transferred,
+                            static_cast<unsigned>(operation->buffer.size() - operation->transferred), static_cast<__u64>(operation->transferred));
+        break;
+
+    case Operation::Step::Close:
+        io_uring_prep_close(sqe, operation->descriptor);
+        break;
+
+    case Operation::Step::Rename:
+        io_uring_prep_renameat(sqe, AT_FDCWD, operation->path.constData(), AT_FDCWD, operation->targetPath.constData(), 0);
+        break;
+
+    case Operation::Step::Unlink:
+        io_uring_prep_unlinkat(sqe, AT_FDCWD, operation->path.constData(), 0);
+        break;
+
+    case Operation::Step::Stop:
+        io_uring_prep_nop(sqe);
+        break;
+    }
+
+    io_uring_sqe_set_data(sqe, operation);
+}
+
+void IoUringQueue::complete(Operation *operation, int result)
+{
+    switch (operation->step)
+    {
+    case Operation::Step::Open:
+        if (result < 0)
+        {
+            operation->failed = true;
+            finish(operation);
+            return;
+        }
+
+        operation->descriptor = result;
+        operation->step = operation->buffer.isEmpty() ? Operation::Step::Close : (operation->writing ? Operation::Step::Write : Operation::Step::Read);
+        break;
+
+    case Operation::Step::Read:
+    case Operation::Step::Write:
+        //a short read or write continues where it stopped, end of file or an error closes the file
+        if (result < 0 || (result == 0 && operation->writing))
+            operation->failed = true;
+        else
+            operation->transferred += result;
+
+        if (operation->failed || result == 0 || operation->transferred >= operation->buffer.size())
+            operation->step = Operation::Step::Close;
+
+        break;
+
+    case Operation::Step::Close:
+        operation->descriptor = -1;
+
+        if (result < 0)
+            operation->failed = true;
+
+        if (!operation->writing)
+        {
+            finish(operation);
+            return;
+        }
+
+        //a failed write removes its temporary file
+        operation->step = operation->failed ? Operation::Step::Unlink : Operation::Step::Rename;
+        break;
+
+    case Operation::Step::Rename:
+        if (result < 0)
+        {
+            operation->failed = true;
+            operation->step = Operation::Step::Unlink;
+            break;
+        }
+
+        finish(operation);
+        return;
+
+    case Operation::Step::Unlink:
+        if (!operation->batch)
+        {
+            finish(operation);
+            return;
+        }
+
+        if (result == 0)
+            ++operation->batch->removed;
+
+        if (--operation->batch->remaining == 0)
+        {
+            operation->batch->promise.addResult(operation->batch->removed);
+            operation->batch->promise.finish();
+
+            m_inFlight.fetch_sub(1);
+        }
+
+        delete operation;
+        release();
+        return;
+
+    case Operation::Step::Stop:
+        delete operation;
+        release();
+        return;
+    }
+
+    submit(operation);
+}
+
+void IoUringQueue::finish(Operation *operation)
+{
+    if (operation->writing)
+    {
+        operation->writePromise.addResult(!operation->failed);
+        operation->writePromise.finish();
+    }
+    else
+    {
+        if (operation->failed)
+            operation->buffer = QByteArray {};
+        else
+            operation->buffer.truncate(operation->transferred);
+
+        operation->readPromise.addResult(operation->buffer);
+        operation->readPromise.finish();
+    }
+
+    delete operation;
+    release();
+
+    m_inFlight.fetch_sub(1);
+}
+
+void IoUringQueue::run()
+{
+    bool stopping {false};
+
+    //operations submitted before the destructor are still completed
+    while (!stopping || m_inFlight.load() > 0)
+    {
+        io_uring_cqe *cqe {nullptr};
+
+        if (io_uring_wait_cqe(&m_ring, &cqe) < 0)
+            continue;
+
+        Operation * const operation {static_cast<Operation *>(io_uring_cqe_get_data(cqe))};
+        const int result {cqe->res};
+
+        io_uring_cqe_seen(&m_ring, cqe);
+
+        if (operation->step == Operation::Step::Stop)
+            stopping = true;
+
+        complete(operation, result);
+    }
+}
+
+#endif // LINECHART_IO_URING
@@ -0,0 +1,111 @@
+#ifndef IOURINGQUEUE_H
+#define IOURINGQUEUE_H
+
+#ifdef LINECHART_IO_URING
+
+#include <QScopedPointer>
+#include <QByteArray>
+#include <QPromise>
+#include <QFuture>
+#include <QThread>
+#include <QMutex>
+#include <QStringList>
+#include <QString>
+#include <QVector>
+
+#include <liburing.h>
+
+#include <memory>
+#include <atomic>
+#include <deque>
+
+/* Asynchronous file operations of the ChartStore on one io_uring. Every
+   operation is a short chain of open/read/write/close/rename/unlink requests;
+   a request is submitted from the calling thread, the completion thread
+   reaps the results and submits the next step, so neither ever blocks on
+   the disk. At most as many operations as the ring has entries run at once,
+   so neither ring can overflow; further operations wait in a queue and are
+   started by the completion thread as running ones finish. Only built with CONFIG += io_uring, check isValid() after
+   construction: kernels without io_uring or without the required opcodes
+   (Linux 5.11) and sandboxes which forbid it leave the queue invalid. */
+
+class IoUringQueue
+{
+public:
+    explicit IoUringQueue(unsigned entries);
+    ~IoUringQueue();
+
+    bool isValid() const;
+
+    //the first size bytes of path, a null QByteArray on failure
+    QFuture<QByteArray> read(const QString &path, qint64 size);
+
+    //writes temporaryPath and renames it to path
+    QFuture<bool> write(const QString &temporaryPath, const QString &path, const QByteArray &bytes);
+
+    //submitted together as far as there is room in the ring, the number of removed files
+    QFuture<int> unlink(const QStringList &paths);
+
+private:
+    struct UnlinkBatch
+    {
+        QPromise<int> promise;
+        int           remaining {0};
+        int           removed   {0};
+    };
+
+    struct Operation
+    {
+        enum class Step {Open, Read, Write, Close, Rename, Unlink, Stop};
+
+        Step       step {Step::Open};
+        QByteArray path;
+        QByteArray targetPath;
+        QByteArray buffer;
+        qint64     transferred {0};
+        int        descriptor  {-1};
+        bool       writing     {false};
+        bool       failed      {false};
+
+        QPromise<QByteArray> readPromise;
+        QPromise<bool>       writePromise;
+
+        std::shared_ptr<UnlinkBatch> batch;
+    };
+
+    //starts new operations, those which do not fit into the ring are queued
+    void start(const QVector<Operation *> &operations);
+
+    //submits the next step of a running operation
+    void submit(Operation *operation);
+
+    //frees the slot of a finished operation for the next queued one
+    void release();
+
+    //the caller holds m_submitMutex
+    void prepare(Operation *operation);
+    void submitPrepared();
+
+    void complete(Operation *operation, int result);
+    void finish(Operation *operation);
+
+    void run();
+
+    io_uring m_ring;
+    bool     m_valid {false};
+
+    QMutex m_submitMutex;
+
+    //guarded by m_submitMutex
+    const unsigned          m_capacity;
+    unsigned                m_running {0};
+    std::deque<Operation *> m_queued;
+
+    std::atomic<int> m_inFlight {0};
+
+    QScopedPointer<QThread> m_completionThread;
+};
+
+#endif // LINECHART_IO_URING
+
+#endif // IOURINGQUEUE_H
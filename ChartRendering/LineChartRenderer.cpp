@@ -0,0 +1,145 @@
+#include "LineChartRenderer.h"
+
+#include <QPainter>
+#include <QPicture>
+#include <QGraphicsScene>
+#include <QGraphicsLayout>
+
+#include <QChart>
+#include <QLineSeries>
+#include <QValueAxis>
+
+#include <algorithm>
+
+#include "CommonUtilities/CommonUtilities.h"
+#include "ImageBufferPool.h"
+#include "StageTimings.h"
+
+void selectOffscreenPlatform()
+{
+    //an explicit QT_QPA_PLATFORM, e.g. xcb for debugging, still wins
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+}
+
+namespace
+{
+    //the scene takes ownership of the chart
+    void populateScene(QGraphicsScene *scene, const LineChartSpec &spec, StageTimings *timings)
+    {
+        StageClock clock {timings};
+
+        QChart * const chart {new QChart};
+        scene->addItem(chart);
+
+        /* die axisX und axisY dürfen nicht deleted werden,
+           da das Chart-Objekt hierfür die Ownership übernimmt */
+
+        QValueAxis * const axisX {new QValueAxis};
+        axisX->setRange(spec.xStart, spec.xEnd);
+        axisX->setTickCount(static_cast<int>(axisX->max() + 1));
+        chart->addAxis(axisX, Qt::AlignBottom);
+
+        QValueAxis * const axisY {new QValueAxis};
+        axisY->setRange(spec.yStart, spec.yEnd);
+        axisY->setTickCount(static_cast<int>(axisY->max() + 1));
+        chart->addAxis(axisY, Qt::AlignLeft);
+
+        for (const QString &caption : spec.captionToPoints.keys())
+        {
+            const QVector<QPointF> coordinates {mergeCoordinates(spec.captionToPoints.value(caption).first, spec.captionToPoints.value(caption).second)};
+
+            /* der lineSeries-Pointer darf nicht deleted werden,
+               da das Chart-Objekt hierfür die Ownership übernimmt */
+
+            QLineSeries * const lineSeries {new QLineSeries {chart}};
+            lineSeries->append(coordinates);
+            lineSeries->setColor(generateRandomQColor());
+            lineSeries->setName(caption);
+
+            chart->addSeries(lineSeries);
+
+            lineSeries->attachAxis(axisX);
+            lineSeries->attachAxis(axisY);
+        }
+
+        clock.lap(StageTimings::Stage::Build);
+
+        //the layout would otherwise only be activated by the first paint and be booked as raster time
+        chart->setGeometry(scene->sceneRect());
+
+        if (chart->layout())
+            chart->layout()->activate();
+
+        clock.lap(StageTimings::Stage::Layout);
+    }
+}
+
+QImage renderLineChart(const LineChartSpec &spec)
+{
+    const QRectF imageRect {0, 0, qreal(spec.width), qreal(spec.height)};
+
+    QGraphicsScene scene {imageRect};
+    populateScene(&scene, spec, nullptr);
+
+    //paint the scene straight into a pooled, white cleared image, no widget, window or platform surface involved
+    QImage image {ImageBufferPool::globalInstance()->acquire({spec.width, spec.height})};
+
+    if (image.isNull())
+        return image;
+
+    QPainter painter {&image};
+    painter.setRenderHint(QPainter::Antialiasing);
+    scene.render(&painter, imageRect, imageRect);
+    painter.end();
+
+    return image;
+}
+
+bool renderLineChartBands(const LineChartSpec &spec, int bandHeight, const std::function<bool(const QImage &)> &consumer, StageTimings *timings)
+{
+    const QRectF imageRect {0, 0, qreal(spec.width), qreal(spec.height)};
+
+    QGraphicsScene scene {imageRect};
+    populateScene(&scene, spec, timings);
+
+    StageClock clock {timings};
+
+    //the scene is walked once into a recording, the bands only replay the recorded paint commands clipped to their rows
+    QPicture picture;
+
+    {
+        QPainter recorder {&picture};
+        recorder.setRenderHint(QPainter::Antialiasing);
+        scene.render(&recorder, imageRect, imageRect);
+    }
+
+    bandHeight = std::max(bandHeight, 1);
+
+    for (int top {0}; top < spec.height; top += bandHeight)
+    {
+        const int rows {std::min(bandHeight, spec.height - top)};
+
+        QImage band {ImageBufferPool::globalInstance()->acquire({spec.width, rows})};
+
+        if (band.isNull())
+            return false;
+
+        QPainter painter {&band};
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.translate(0, -top);
+        painter.setClipRect(QRect {0, top, spec.width, rows});
+        painter.drawPicture(0, 0, picture);
+        painter.end();
+
+        clock.lap(StageTimings::Stage::Raster);
+
+        //the consumer gets the band before the next one is painted, the band's buffer goes back to the pool once it dropped every copy
+        if (!consumer(band))
+            return false;
+
+        clock.restart();
+    }
+
+    return true;
+}
@@ -0,0 +1,25 @@
+#ifndef LINECHARTRENDERER_H
+#define LINECHARTRENDERER_H
+
+#include <QImage>
+
+#include <functional>
+
+#include "LineChartSpec.h"
+
+class StageTimings;
+
+/* QtCharts draws through QGraphicsWidget and therefore still needs a QApplication,
+   but not a display: call this before the QApplication is constructed */
+void selectOffscreenPlatform();
+
+QImage renderLineChart(const LineChartSpec &spec);
+
+/* renders the chart and passes it top to bottom in bands of bandHeight rows to consumer,
+   each band is rasterized into its own pooled buffer right before it is passed on, so only
+   the bands the consumer still holds are in memory; stops and fails when consumer returns false.
+   If timings is set, the build, layout and raster stages are added to it, the time
+   spent in consumer is not */
+bool renderLineChartBands(const LineChartSpec &spec, int bandHeight, const std::function<bool(const QImage &)> &consumer, StageTimings *timings = nullptr);
+
+#endif // LINECHARTRENDERER_H
@@ -0,0 +1,200 @@
+#include "LineChartSpec.h"
+
+#include <QJsonArray>
+
+#include <algorithm>
+#include <cmath>
+
+#include "CommonUtilities/CommonUtilities.h"
+
+bool parseLineChartSpec(const QJsonObject &jsonObject, LineChartSpec *spec, QString *errorMessage)
+{
+    const auto reject = [errorMessage](const QString &message)
+    {
+        if (errorMessage)
+            *errorMessage = message;
+
+        return false;
+    };
+
+    for (const QString &key : {"X_Start", "X_End", "Points"})
+    {
+        if (!jsonObject.contains(key))
+            return reject(QString{"Invalid data sent. Missing JSON-Key '%0'. Please send a valid JSON-Object."}.arg(key));
+    }
+
+    if (!jsonObject.value("X_Start").isDouble())
+        return reject("Invalid data sent. JSON-Key 'X_Start' is not a double value. Please send a valid JSON-Object.");
+
+    if (!jsonObject.value("X_End").isDouble())
+        return reject("Invalid data sent. JSON-Key 'X_End' is not a double value. Please send a valid JSON-Object.");
+
+    if (!jsonObject.value("Points").isArray())
+        return reject("Invalid data sent. JSON-Key 'Points' is not an array. Please send a valid JSON-Object.");
+
+    for (const QString &key : {"Width", "Height"})
+    {
+        if (!jsonObject.contains(key))
+            continue;
+
+        const double size {jsonObject.value(key).toDouble(-1)};
+
+        if (size < LineChartSpec::MinimumSize || size > LineChartSpec::MaximumSize || size != std::floor(size))
+            return reject(QString{"Invalid data sent. JSON-Key '%0' is not an integer between %1 and %2. Please send a valid JSON-Object."}
+                          .arg(key).arg(LineChartSpec::MinimumSize).arg(LineChartSpec::MaximumSize));
+    }
+
+    const QJsonArray jsonArray {jsonObject.value("Points").toArray()};
+
+    if (jsonArray.isEmpty())
+        return reject("Invalid data sent. JSON-Key 'Points' is empty. Please send a valid JSON-Object.");
+
+    if (jsonArray.size() > 1)
+        return reject("Invalid data sent. JSON-Key 'Points' contains more than one array. Please send a valid JSON-Object.");
+
+    if (jsonArray.first().isNull())
+        return reject("Invalid data sent. Array in JSON-Key 'Points' contains no JSON subobjects. Please send a valid JSON-Object.");
+
+    for (const QJsonValueConstRef arrayValue : jsonArray.first().toArray())
+    {
+        if (!arrayValue.isObject())
+            return reject("Invalid data sent. A sub-object in array 'Points' is not a proper JSON-object. Please send a valid JSON-Object.");
+
+        const QJsonObject arrayObject {arrayValue.toObject()};
+
+        if (arrayObject.value("Caption").toString().isEmpty())
+            return reject("Invalid data sent. A caption of one sub-object in array 'Points' is empty. Please send a valid JSON-Object.");
+
+        if (!arrayObject.value("X_Points").isArray())
+            return reject("Invalid data sent. JSON-Key 'X_Points' of one sub-object in array 'Points' is not an array. Please send a valid JSON-Object.");
+
+        if (!arrayObject.value("Y_Points").isArray())
+            return reject("Invalid data sent. JSON-Key 'Y_Points' of one sub-object in array 'Points' is not an array. Please send a valid JSON-Object.");
+
+        for (const QJsonValueConstRef subObject : arrayObject.value("Y_Points").toArray())
+        {
+            if (!subObject.isDouble())
+                return reject("Invalid data sent. A point in JSON-Key 'Y_Points' in one sub-object of 'Points' is not a double value. Please send a valid JSON-Object.");
+        }
+    }
+
+    if (!spec)
+        return true;
+
+    spec->xStart = jsonObject.value("X_Start").toDouble();
+    spec->xEnd   = jsonObject.value("X_End").toDouble();
+    spec->width  = jsonObject.value("Width").toInt(LineChartSpec::DefaultWidth);
+    spec->height = jsonObject.value("Height").toInt(LineChartSpec::DefaultHeight);
+
+    const QVector<QJsonObject> pointsObjects = [](const QJsonArray &pointsArray) -> QVector<QJsonObject>
+    {
+        QVector<QJsonObject> pointsObjects;
+
+        for (const QJsonValueConstRef value : pointsArray)
+        {
+            for (const QJsonValueConstRef &arrayValue : value.toArray())
+                pointsObjects << arrayValue.toObject();
+        }
+
+        return pointsObjects;
+
+    }(jsonArray);
+
+    spec->captionToPoints = [](const QVector<QJsonObject> &yPointsObjects) -> QMap<QString, QPair<QVector<qreal>, QVector<qreal> > >
+    {
+        QMap<QString, QPair<QVector<qreal>, QVector<qreal> > > captionToPoints;
+
+        for (const QJsonObject &object : yPointsObjects)
+        {
+            const QString caption {object.value("Caption").toString()};
+
+            const QVector<qreal> xPoints {convertFromArrayToRealsVector(object.value("X_Points").toArray())};
+            const QVector<qreal> yPoints {convertFromArrayToRealsVector(object.value("Y_Points").toArray())};
+
+            captionToPoints.insert(caption, {xPoints, yPoints});
+        }
+
+        return captionToPoints;
+
+    }(pointsObjects);
+
+    spec->yStart = [](const QMap<QString, QPair<QVector<qreal>, QVector<qreal> > > &captionToPoints) -> qreal
+    {
+        QVector<qreal> allYPoints;
+
+        for (const QString &caption : captionToPoints.keys())
+            allYPoints << captionToPoints.value(caption).second;
+
+        if (allYPoints.size() > 1)
+            return *std::min_element(allYPoints.begin(), allYPoints.end());
+
+        return 0;
+
+    }(spec->captionToPoints);
+
+    spec->yEnd = [](const QMap<QString, QPair<QVector<qreal>, QVector<qreal> > > &captionToPoints) -> qreal
+    {
+        QVector<qreal> allYPoints;
+
+        for (const QString &caption : captionToPoints.keys())
+            allYPoints << captionToPoints.value(caption).second;
+
+        if (allYPoints.size() > 1)
+            return *std::max_element(allYPoints.begin(), allYPoints.end());
+
+        return 0;
+
+    }(spec->captionToPoints);
+
+    return true;
+}
+
+int lineChartPointCount(const LineChartSpec &spec)
+{
+    int pointCount {0};
+
+    for (const QPair<QVector<qreal>, QVector<qreal> > &points : std::as_const(spec.captionToPoints))
+        pointCount += points.second.size();
+
+    return pointCount;
+}
+
+QDataStream &operator<<(QDataStream &stream, const LineChartSpec &spec)
+{
+    return stream << spec.xStart << spec.xEnd << spec.yStart << spec.yEnd << spec.width << spec.height << spec.captionToPoints;
+}
+
+QDataStream &operator>>(QDataStream &stream, LineChartSpec &spec)
+{
+    return stream >> spec.xStart >> spec.xEnd >> spec.yStart >> spec.yEnd >> spec.width >> spec.height >> spec.captionToPoints;
+}
+
+QByteArray packLineChartSpec(const LineChartSpec &spec)
+{
+    QByteArray bytes;
+
+    QDataStream stream {&bytes, QDataStream::OpenModeFlag::WriteOnly};
+    stream.setVersion(QDataStream::Version::Qt_6_0);
+    stream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::DoublePrecision);
+    stream << spec;
+
+    return bytes;
+}
+
+bool unpackLineChartSpec(const QByteArray &bytes, LineChartSpec *spec)
+{
+    LineChartSpec unpacked;
+
+    QDataStream stream {bytes};
+    stream.setVersion(QDataStream::Version::Qt_6_0);
+    stream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::DoublePrecision);
+    stream >> unpacked;
+
+    if (stream.status() != QDataStream::Status::Ok || !stream.atEnd())
+        return false;
+
+    if (spec)
+        *spec = unpacked;
+
+    return true;
+}
@@ -0,0 +1,42 @@
+#ifndef LINECHARTSPEC_H
+#define LINECHARTSPEC_H
+
+#include <QJsonObject>
+#include <QDataStream>
+#include <QVector>
+#include <QString>
+#include <QPair>
+#include <QMap>
+
+struct LineChartSpec
+{
+    static constexpr int DefaultWidth  {1024};
+    static constexpr int DefaultHeight {768};
+    static constexpr int MinimumSize   {64};
+    static constexpr int MaximumSize   {4096};
+
+    qreal xStart {0};
+    qreal xEnd   {0};
+    qreal yStart {0};
+    qreal yEnd   {0};
+
+    int width  {DefaultWidth};
+    int height {DefaultHeight};
+
+    QMap<QString, QPair<QVector<qreal>, QVector<qreal> > > captionToPoints;
+};
+
+//validates the /line JSON-object, on failure errorMessage holds the message for the client
+bool parseLineChartSpec(const QJsonObject &jsonObject, LineChartSpec *spec, QString *errorMessage);
+
+//points of all series together
+int lineChartPointCount(const LineChartSpec &spec);
+
+QDataStream &operator<<(QDataStream &stream, const LineChartSpec &spec);
+QDataStream &operator>>(QDataStream &stream, LineChartSpec &spec);
+
+//compact binary form of a parsed spec, stored instead of the PNG while a chart is rendered lazily
+QByteArray packLineChartSpec(const LineChartSpec &spec);
+bool unpackLineChartSpec(const QByteArray &bytes, LineChartSpec *spec);
+
+#endif // LINECHARTSPEC_H
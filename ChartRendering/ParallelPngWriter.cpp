@@ -0,0 +1,170 @@
+#include "ParallelPngWriter.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtEndian>
+
+#include <algorithm>
+#include <numeric>
+
+#include "ZlibBackend.h"
+
+namespace
+{
+    constexpr int WindowSize    {32 * 1024};
+    constexpr int IdatSize      {64 * 1024};
+    constexpr int BytesPerPixel {3};
+
+    ParallelPngWriter::Chunk deflateChunk(const QByteArray &data, const QByteArray &dictionary, int level, bool last)
+    {
+        ParallelPngWriter::Chunk chunk;
+        chunk.length = data.size();
+        chunk.adler  = static_cast<quint32>(adler32(adler32(0L, nullptr, 0), reinterpret_cast<const unsigned char *>(data.constData()), static_cast<unsigned int>(data.size())));
+
+        ZlibStream stream {};
+
+        //raw deflate, the zlib header and checksum are written once for the whole stream
+        if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_FILTERED) != Z_OK)
+            return chunk;
+
+        if (!dictionary.isEmpty())
+            deflateSetDictionary(&stream, reinterpret_cast<const unsigned char *>(dictionary.constData()), static_cast<unsigned int>(dictionary.size()));
+
+        stream.next_in  = reinterpret_cast<unsigned char *>(const_cast<char *>(data.constData()));
+        stream.avail_in = static_cast<unsigned int>(data.size());
+
+        //a sync flush keeps the chunk open and byte aligned, only the last chunk sets the final block bit
+        const int flush {last ? Z_FINISH : Z_SYNC_FLUSH};
+
+        chunk.deflated.resize(static_cast<qsizetype>(deflateBound(&stream, static_cast<unsigned long>(data.size()))) + 64);
+
+        qsizetype produced {0};
+
+        for (;;)
+        {
+            stream.next_out  = reinterpret_cast<unsigned char *>(chunk.deflated.data()) + produced;
+            stream.avail_out = static_cast<unsigned int>(chunk.deflated.size() - produced);
+
+            const int result {deflate(&stream, flush)};
+
+            produced = chunk.deflated.size() - stream.avail_out;
+
+            if (result == Z_STREAM_ERROR)
+                break;
+
+            if (last ? result == Z_STREAM_END : stream.avail_out != 0)
+            {
+                chunk.ok = true;
+                break;
+            }
+
+            chunk.deflated.resize(chunk.deflated.size() * 2);
+        }
+
+        deflateEnd(&stream);
+
+        chunk.deflated.resize(produced);
+        return chunk;
+    }
+
+    int zlibLevel(int compressionLevel)
+    {
+        return compressionLevel < 0 ? Z_DEFAULT_COMPRESSION : std::min(compressionLevel, 9);
+    }
+}
+
+ParallelPngWriter::ParallelPngWriter(const QSize &size, int compressionLevel, QThreadPool *pool, QByteArray *bytes) :
+    m_size             {size},
+    m_compressionLevel {zlibLevel(compressionLevel)},
+    m_pool             {pool ? pool : QThreadPool::globalInstance()},
+    m_bytes            {bytes}
+{
+    if (m_bytes)
+        *m_bytes = pngHeader(m_size);
+}
+
+ParallelPngWriter::~ParallelPngWriter()
+{
+    for (QFuture<Chunk> &chunk : m_chunks)
+        chunk.waitForFinished();
+}
+
+bool ParallelPngWriter::writeRows(const QImage &rows)
+{
+    if (!m_bytes || rows.width() != m_size.width() || m_rowsWritten + rows.height() > m_size.height())
+        return false;
+
+    if (rows.height() == 0)
+        return true;
+
+    //bounds the bands and scanlines waiting for a worker
+    const int chunksInFlight {2 * std::max(m_pool->maxThreadCount(), 1)};
+
+    if (m_chunks.size() >= chunksInFlight)
+        m_chunks.at(m_chunks.size() - chunksInFlight).waitForFinished();
+
+    const QFuture<QByteArray> scanlines {QtConcurrent::run(m_pool, [width = m_size.width(), rows, previousRow = m_lastRow]()
+    {
+        return PngRowFilter{width, previousRow}.filter(rows);
+    })};
+
+    /* the dictionary is the last 32 KiB of the scanlines before the chunk, even across small bands; the bands
+       before were queued earlier, so they are filtered or being filtered when the chunk waits for them */
+    m_chunks << scanlines.then(m_pool, [window = m_window, level = m_compressionLevel](const QByteArray &filtered)
+    {
+        QByteArray dictionary;
+
+        for (const FilteredBand &band : window)
+            dictionary += band.scanlines.result();
+
+        return deflateChunk(filtered, dictionary.right(WindowSize), level, false);
+    });
+
+    m_window << FilteredBand {scanlines, (qint64{m_size.width()} * BytesPerPixel + 1) * rows.height()};
+
+    while (m_window.size() > 1 && std::accumulate(m_window.cbegin() + 1, m_window.cend(), qint64{0}, [](qint64 length, const FilteredBand &band) { return length + band.length; }) >= WindowSize)
+        m_window.removeFirst();
+
+    m_lastRow = rows.copy(0, rows.height() - 1, rows.width(), 1);
+    m_rowsWritten += rows.height();
+
+    return true;
+}
+
+bool ParallelPngWriter::finish()
+{
+    if (!m_bytes || m_rowsWritten != m_size.height())
+        return false;
+
+    //an empty final chunk carries the final block bit
+    m_chunks << QtConcurrent::run(m_pool, deflateChunk, QByteArray{}, QByteArray{}, m_compressionLevel, true);
+
+    QByteArray zlibStream {"\x78\x9c", 2};
+    quint32 adler {static_cast<quint32>(adler32(0L, nullptr, 0))};
+
+    bool ok {true};
+
+    for (QFuture<Chunk> &future : m_chunks)
+    {
+        const Chunk chunk {future.result()};
+
+        ok = ok && chunk.ok;
+        zlibStream += chunk.deflated;
+        adler = static_cast<quint32>(adler32_combine(adler, chunk.adler, chunk.length));
+    }
+
+    m_chunks.clear();
+
+    if (!ok)
+        return false;
+
+    char checksum[4];
+    qToBigEndian<quint32>(adler, checksum);
+    zlibStream.append(checksum, 4);
+
+    for (qsizetype offset {0}; offset < zlibStream.size(); offset += IdatSize)
+        appendPngChunk(m_bytes, "IDAT", zlibStream.mid(offset, IdatSize));
+
+    appendPngChunk(m_bytes, "IEND", {});
+
+    return true;
+}
@@ -0,0 +1,63 @@
+#ifndef PARALLELPNGWRITER_H
+#define PARALLELPNGWRITER_H
+
+#include <QThreadPool>
+#include <QByteArray>
+#include <QFuture>
+#include <QImage>
+#include <QList>
+#include <QSize>
+
+#include "PngFormat.h"
+
+/* Writes the same 8 bit RGB PNG as PngStreamWriter, but deflates the bands in
+   parallel, pigz style: every band becomes an independent raw deflate chunk on
+   pool, primed with the last 32 KiB of the preceding scanlines as dictionary and
+   ended with a sync flush, so the chunks concatenate into one valid zlib stream.
+   The checksum is combined from the per chunk adler32 values. Pays off for large
+   images, where a single deflate stream is the bottleneck. The rows are filtered
+   by the chunk's worker as well, starting from the last row of the band before;
+   writeRows() must be called top to bottom from one thread and blocks while
+   twice the pool's threads of bands wait for their workers. */
+
+class ParallelPngWriter
+{
+public:
+    ParallelPngWriter(const QSize &size, int compressionLevel, QThreadPool *pool, QByteArray *bytes);
+    ~ParallelPngWriter();
+
+    bool writeRows(const QImage &rows);
+
+    //waits for all chunks, then writes the IDAT and IEND chunks
+    bool finish();
+
+    struct Chunk
+    {
+        QByteArray deflated;
+        quint32    adler  {1};
+        qint64     length {0};
+        bool       ok     {false};
+    };
+
+private:
+    const QSize   m_size;
+    const int     m_compressionLevel;
+    QThreadPool * m_pool;
+    QByteArray  * m_bytes;
+
+    struct FilteredBand
+    {
+        QFuture<QByteArray> scanlines;
+        qint64              length {0};
+    };
+
+    int    m_rowsWritten {0};
+    QImage m_lastRow;
+
+    //the latest bands, as many as the dictionary of the next chunk needs
+    QList<FilteredBand> m_window;
+
+    QList<QFuture<Chunk> > m_chunks;
+};
+
+#endif // PARALLELPNGWRITER_H
@@ -0,0 +1,191 @@
+#include "PngEncoder.h"
+
+#include <QImageWriter>
+#include <QBuffer>
+
+#include <algorithm>
+#include <cstdlib>
+
+#ifdef LINECHART_LIBDEFLATE
+#include <libdeflate.h>
+#include "PngFormat.h"
+#endif
+
+#ifdef LINECHART_SPNG
+#include <spng.h>
+#endif
+
+PngEncoder::PngEncoder(int compressionLevel, Backend backend) :
+    m_compressionLevel {compressionLevel < 0 ? -1 : std::min(compressionLevel, 9)},
+    m_backend          {availableBackends().contains(backend) ? backend : Backend::ImageWriter}
+{
+
+}
+
+int PngEncoder::compressionLevel() const
+{
+    return m_compressionLevel;
+}
+
+PngEncoder::Backend PngEncoder::backend() const
+{
+    return m_backend;
+}
+
+bool PngEncoder::encode(const QImage &image, QByteArray *bytes) const
+{
+    if (!bytes || image.isNull())
+        return false;
+
+    bytes->clear();
+
+    switch (m_backend)
+    {
+    case Backend::Libdeflate: return encodeWithLibdeflate(image, bytes);
+    case Backend::Spng:       return encodeWithSpng(image, bytes);
+    case Backend::ImageWriter: break;
+    }
+
+    return encodeWithImageWriter(image, bytes);
+}
+
+PngEncoder::Backend PngEncoder::defaultBackend()
+{
+#if defined(LINECHART_LIBDEFLATE)
+    return Backend::Libdeflate;
+#elif defined(LINECHART_SPNG)
+    return Backend::Spng;
+#else
+    return Backend::ImageWriter;
+#endif
+}
+
+QVector<PngEncoder::Backend> PngEncoder::availableBackends()
+{
+    QVector<Backend> backends {Backend::ImageWriter};
+
+#ifdef LINECHART_LIBDEFLATE
+    backends << Backend::Libdeflate;
+#endif
+
+#ifdef LINECHART_SPNG
+    backends << Backend::Spng;
+#endif
+
+    return backends;
+}
+
+QString PngEncoder::backendName(Backend backend)
+{
+    switch (backend)
+    {
+    case Backend::ImageWriter: return "QImageWriter";
+    case Backend::Libdeflate:  return "libdeflate";
+    case Backend::Spng:        return "spng";
+    }
+
+    return {};
+}
+
+bool PngEncoder::encodeWithImageWriter(const QImage &image, QByteArray *bytes) const
+{
+    QBuffer buffer {bytes};
+
+    if (!buffer.open(QBuffer::OpenModeFlag::WriteOnly))
+        return false;
+
+    QImageWriter imageWriter {&buffer, "PNG"};
+
+    //Qt's PNG writer derives the zlib level from the quality: level = (100 - quality) * 9 / 91
+    if (m_compressionLevel >= 0)
+        imageWriter.setQuality(100 - (m_compressionLevel * 91 + 8) / 9);
+
+    return imageWriter.write(image);
+}
+
+bool PngEncoder::encodeWithLibdeflate(const QImage &image, QByteArray *bytes) const
+{
+#ifdef LINECHART_LIBDEFLATE
+    //libdeflate has no streaming API, the whole filtered image is compressed in one call
+    const QByteArray scanlines {PngRowFilter{image.width()}.filter(image)};
+
+    libdeflate_compressor * const compressor {libdeflate_alloc_compressor(m_compressionLevel < 0 ? 6 : m_compressionLevel)};
+
+    if (!compressor)
+        return false;
+
+    QByteArray compressed (static_cast<qsizetype>(libdeflate_zlib_compress_bound(compressor, static_cast<size_t>(scanlines.size()))), '\0');
+
+    const size_t compressedSize {libdeflate_zlib_compress(compressor, scanlines.constData(), static_cast<size_t>(scanlines.size()), compressed.data(), static_cast<size_t>(compressed.size()))};
+
+    libdeflate_free_compressor(compressor);
+
+    if (compressedSize == 0)
+        return false;
+
+    compressed.truncate(static_cast<qsizetype>(compressedSize));
+
+    *bytes = pngHeader(image.size());
+    appendPngChunk(bytes, "IDAT", compressed);
+    appendPngChunk(bytes, "IEND", {});
+
+    return true;
+#else
+    Q_UNUSED(image)
+    Q_UNUSED(bytes)
+    return false;
+#endif
+}
+
+bool PngEncoder::encodeWithSpng(const QImage &image, QByteArray *bytes) const
+{
+#ifdef LINECHART_SPNG
+    const QImage rgbImage {image.convertToFormat(QImage::Format_RGB888)};
+
+    spng_ctx * const context {spng_ctx_new(SPNG_CTX_ENCODER)};
+
+    if (!context)
+        return false;
+
+    spng_set_option(context, SPNG_ENCODE_TO_BUFFER, 1);
+
+    if (m_compressionLevel >= 0)
+        spng_set_option(context, SPNG_IMG_COMPRESSION_LEVEL, m_compressionLevel);
+
+    spng_ihdr header {};
+    header.width      = static_cast<uint32_t>(rgbImage.width());
+    header.height     = static_cast<uint32_t>(rgbImage.height());
+    header.bit_depth  = 8;
+    header.color_type = SPNG_COLOR_TYPE_TRUECOLOR;
+
+    spng_set_ihdr(context, &header);
+
+    //QImage pads its scanlines to 4 bytes, so the rows are handed over one by one
+    int result {spng_encode_image(context, nullptr, 0, SPNG_FMT_PNG, SPNG_ENCODE_PROGRESSIVE | SPNG_ENCODE_FINALIZE)};
+
+    for (int y {0}; result == 0; ++y)
+        result = spng_encode_row(context, rgbImage.constScanLine(y), static_cast<size_t>(rgbImage.width()) * 3);
+
+    bool encoded {false};
+
+    if (result == SPNG_EOI)
+    {
+        size_t size {0};
+        void * const buffer {spng_get_png_buffer(context, &size, &result)};
+
+        if (buffer)
+        {
+            *bytes = QByteArray {static_cast<const char *>(buffer), static_cast<qsizetype>(size)};
+            std::free(buffer);
+            encoded = true;
+        }
+    }
+
+    spng_ctx_free(context);
+    return encoded;
+#else
+    Q_UNUSED(image)
+    Q_UNUSED(bytes)
+    return false;
+#endif
+}
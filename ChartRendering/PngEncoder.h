@@ -0,0 +1,43 @@
+#ifndef PNGENCODER_H
+#define PNGENCODER_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QString>
+#include <QImage>
+
+/* compressionLevel is the zlib level 0 (none) to 9 (best), -1 keeps the default of the backend.
+   QImageWriter is always available, libdeflate and spng only when built with CONFIG+=libdeflate
+   or CONFIG+=spng; the default backend is the fastest one that was built. */
+
+class PngEncoder
+{
+public:
+    enum class Backend
+    {
+        ImageWriter,
+        Libdeflate,
+        Spng
+    };
+
+    explicit PngEncoder(int compressionLevel = -1, Backend backend = defaultBackend());
+
+    int compressionLevel() const;
+    Backend backend() const;
+
+    bool encode(const QImage &image, QByteArray *bytes) const;
+
+    static Backend defaultBackend();
+    static QVector<Backend> availableBackends();
+    static QString backendName(Backend backend);
+
+private:
+    bool encodeWithImageWriter(const QImage &image, QByteArray *bytes) const;
+    bool encodeWithLibdeflate(const QImage &image, QByteArray *bytes) const;
+    bool encodeWithSpng(const QImage &image, QByteArray *bytes) const;
+
+    const int     m_compressionLevel;
+    const Backend m_backend;
+};
+
+#endif // PNGENCODER_H
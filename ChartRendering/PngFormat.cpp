@@ -0,0 +1,168 @@
+#include "PngFormat.h"
+
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "ZlibBackend.h"
+
+namespace
+{
+    constexpr int BytesPerPixel {3};
+
+    enum class Filter : char
+    {
+        None    = 0,
+        Sub     = 1,
+        Up      = 2,
+        Average = 3,
+        Paeth   = 4
+    };
+
+    uchar paethPredictor(int left, int up, int upperLeft)
+    {
+        const int estimate {left + up - upperLeft};
+
+        const int distanceLeft      {std::abs(estimate - left)};
+        const int distanceUp        {std::abs(estimate - up)};
+        const int distanceUpperLeft {std::abs(estimate - upperLeft)};
+
+        if (distanceLeft <= distanceUp && distanceLeft <= distanceUpperLeft)
+            return static_cast<uchar>(left);
+
+        if (distanceUp <= distanceUpperLeft)
+            return static_cast<uchar>(up);
+
+        return static_cast<uchar>(upperLeft);
+    }
+
+    //filtered holds the filter type byte followed by the row
+    void filterRow(const uchar *row, const uchar *previousRow, int length, uchar *filtered, uchar *candidate)
+    {
+        quint64 bestSum {~quint64{0}};
+
+        for (const Filter filter : {Filter::None, Filter::Sub, Filter::Up, Filter::Average, Filter::Paeth})
+        {
+            quint64 sum {0};
+
+            for (int byte {0}; byte < length; ++byte)
+            {
+                const int left      {byte >= BytesPerPixel ? row[byte - BytesPerPixel] : 0};
+                const int up        {previousRow[byte]};
+                const int upperLeft {byte >= BytesPerPixel ? previousRow[byte - BytesPerPixel] : 0};
+
+                uchar predictor {0};
+
+                switch (filter)
+                {
+                case Filter::None:    predictor = 0;                                         break;
+                case Filter::Sub:     predictor = static_cast<uchar>(left);                  break;
+                case Filter::Up:      predictor = static_cast<uchar>(up);                    break;
+                case Filter::Average: predictor = static_cast<uchar>((left + up) / 2);       break;
+                case Filter::Paeth:   predictor = paethPredictor(left, up, upperLeft);       break;
+                }
+
+                candidate[byte] = static_cast<uchar>(row[byte] - predictor);
+                sum += static_cast<quint64>(std::abs(static_cast<int>(static_cast<signed char>(candidate[byte]))));
+            }
+
+            if (sum < bestSum)
+            {
+                bestSum = sum;
+                filtered[0] = static_cast<uchar>(filter);
+                std::copy(candidate, candidate + length, filtered + 1);
+            }
+        }
+    }
+
+    QImage toRgb32(const QImage &image)
+    {
+        return image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32 ? image : image.convertToFormat(QImage::Format_RGB32);
+    }
+
+    void toRgbRow(const QImage &source, int y, int width, uchar *rowBytes)
+    {
+        const QRgb * const pixels {reinterpret_cast<const QRgb *>(source.constScanLine(y))};
+
+        for (int x {0}; x < width; ++x)
+        {
+            rowBytes[x * BytesPerPixel]     = static_cast<uchar>(qRed(pixels[x]));
+            rowBytes[x * BytesPerPixel + 1] = static_cast<uchar>(qGreen(pixels[x]));
+            rowBytes[x * BytesPerPixel + 2] = static_cast<uchar>(qBlue(pixels[x]));
+        }
+    }
+}
+
+QByteArray pngHeader(const QSize &size)
+{
+    QByteArray header (13, '\0');
+    qToBigEndian<quint32>(static_cast<quint32>(size.width()),  header.data());
+    qToBigEndian<quint32>(static_cast<quint32>(size.height()), header.data() + 4);
+    header[8]  = 8;    //bit depth
+    header[9]  = 2;    //color type RGB
+    header[10] = 0;    //deflate
+    header[11] = 0;    //adaptive filtering
+    header[12] = 0;    //no interlace
+
+    QByteArray bytes {"\x89PNG\r\n\x1a\n", 8};
+    appendPngChunk(&bytes, "IHDR", header);
+
+    return bytes;
+}
+
+void appendPngChunk(QByteArray *bytes, const char *type, const QByteArray &data)
+{
+    char length[4];
+    qToBigEndian<quint32>(static_cast<quint32>(data.size()), length);
+
+    quint32 crc {static_cast<quint32>(crc32(0L, reinterpret_cast<const unsigned char *>(type), 4))};
+    crc = static_cast<quint32>(crc32(crc, reinterpret_cast<const unsigned char *>(data.constData()), static_cast<unsigned int>(data.size())));
+
+    char checksum[4];
+    qToBigEndian<quint32>(crc, checksum);
+
+    bytes->append(length, 4);
+    bytes->append(type, 4);
+    bytes->append(data);
+    bytes->append(checksum, 4);
+}
+
+PngRowFilter::PngRowFilter(int width, const QImage &previousRow) :
+    m_width       {std::max(width, 0)},
+    m_previousRow (m_width * BytesPerPixel, '\0')
+{
+    if (!previousRow.isNull() && previousRow.width() == m_width)
+        toRgbRow(toRgb32(previousRow), previousRow.height() - 1, m_width, reinterpret_cast<uchar *>(m_previousRow.data()));
+}
+
+QByteArray PngRowFilter::filter(const QImage &rows)
+{
+    if (rows.width() != m_width)
+        return {};
+
+    const QImage source {toRgb32(rows)};
+
+    const int rowLength {m_width * BytesPerPixel};
+
+    QByteArray row       (rowLength, '\0');
+    QByteArray candidate (rowLength, '\0');
+    QByteArray filtered  ((rowLength + 1) * source.height(), '\0');
+
+    for (int y {0}; y < source.height(); ++y)
+    {
+        uchar * const rowBytes {reinterpret_cast<uchar *>(row.data())};
+
+        toRgbRow(source, y, m_width, rowBytes);
+
+        filterRow(rowBytes,
+                  reinterpret_cast<const uchar *>(m_previousRow.constData()),
+                  rowLength,
+                  reinterpret_cast<uchar *>(filtered.data()) + y * (rowLength + 1),
+                  reinterpret_cast<uchar *>(candidate.data()));
+
+        std::swap(row, m_previousRow);
+    }
+
+    return filtered;
+}
@@ -0,0 +1,33 @@
+#ifndef PNGFORMAT_H
+#define PNGFORMAT_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QSize>
+
+//building blocks shared by the PNG writers, all images are written as 8 bit RGB
+
+//signature and IHDR chunk
+QByteArray pngHeader(const QSize &size);
+
+void appendPngChunk(QByteArray *bytes, const char *type, const QByteArray &data);
+
+/* Turns image rows into the filtered scanlines of the IDAT stream: a filter type
+   byte followed by the filtered RGB bytes per row. Like libpng's default, each
+   row gets the filter with the smallest sum of absolute signed bytes. Keeps the
+   last row, so consecutive calls must pass the rows top to bottom; a filter for
+   rows further down the image starts from the row above them, previousRow. */
+
+class PngRowFilter
+{
+public:
+    explicit PngRowFilter(int width, const QImage &previousRow = {});
+
+    QByteArray filter(const QImage &rows);
+
+private:
+    const int  m_width;
+    QByteArray m_previousRow;
+};
+
+#endif // PNGFORMAT_H
@@ -0,0 +1,97 @@
+#include "PngStreamWriter.h"
+
+#include <algorithm>
+
+#include "ZlibBackend.h"
+
+namespace
+{
+    constexpr int IdatSize {64 * 1024};
+}
+
+PngStreamWriter::PngStreamWriter(const QSize &size, int compressionLevel, QByteArray *bytes) :
+    m_size      {size},
+    m_bytes     {bytes},
+    m_stream    {new ZlibStream {}},
+    m_rowFilter {size.width()}
+{
+    if (!m_bytes || m_size.isEmpty())
+        return;
+
+    const int level {compressionLevel < 0 ? Z_DEFAULT_COMPRESSION : std::min(compressionLevel, 9)};
+
+    if (deflateInit2(m_stream.get(), level, Z_DEFLATED, 15, 8, Z_FILTERED) != Z_OK)
+        return;
+
+    m_valid = true;
+    *m_bytes = pngHeader(m_size);
+}
+
+PngStreamWriter::~PngStreamWriter()
+{
+    if (m_valid)
+        deflateEnd(m_stream.get());
+}
+
+bool PngStreamWriter::writeRows(const QImage &rows)
+{
+    if (!m_valid || rows.width() != m_size.width() || m_rowsWritten + rows.height() > m_size.height())
+        return false;
+
+    if (!deflateRows(m_rowFilter.filter(rows), Z_NO_FLUSH))
+        return false;
+
+    m_rowsWritten += rows.height();
+    return true;
+}
+
+bool PngStreamWriter::finish()
+{
+    if (!m_valid || m_rowsWritten != m_size.height())
+        return false;
+
+    if (!deflateRows({}, Z_FINISH))
+        return false;
+
+    if (!m_idat.isEmpty())
+        appendPngChunk(m_bytes, "IDAT", m_idat);
+
+    appendPngChunk(m_bytes, "IEND", {});
+
+    deflateEnd(m_stream.get());
+    m_valid = false;
+
+    return true;
+}
+
+bool PngStreamWriter::deflateRows(const QByteArray &rows, int flush)
+{
+    m_stream->next_in  = reinterpret_cast<unsigned char *>(const_cast<char *>(rows.constData()));
+    m_stream->avail_in = static_cast<unsigned int>(rows.size());
+
+    for (;;)
+    {
+        const int used {static_cast<int>(m_idat.size())};
+
+        m_idat.resize(IdatSize);
+        m_stream->next_out  = reinterpret_cast<unsigned char *>(m_idat.data()) + used;
+        m_stream->avail_out = static_cast<unsigned int>(IdatSize - used);
+
+        const int result {deflate(m_stream.get(), flush)};
+
+        if (result == Z_STREAM_ERROR)
+            return false;
+
+        m_idat.resize(IdatSize - static_cast<int>(m_stream->avail_out));
+
+        if (m_idat.size() == IdatSize)
+        {
+            appendPngChunk(m_bytes, "IDAT", m_idat);
+            m_idat.clear();
+        }
+
+        //with room left in the output, deflate has consumed all input
+        if (flush == Z_FINISH ? result == Z_STREAM_END : m_stream->avail_out != 0)
+            return true;
+    }
+}
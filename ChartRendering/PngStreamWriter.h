@@ -0,0 +1,44 @@
+#ifndef PNGSTREAMWRITER_H
+#define PNGSTREAMWRITER_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QSize>
+
+#include <memory>
+
+#include "PngFormat.h"
+
+struct ZlibStream;
+
+/* Writes an 8 bit RGB PNG row by row. writeRows() filters and deflates the rows
+   of one band and emits IDAT chunks as soon as the compressor hands out 64 KiB,
+   so an image never has to exist as a whole. The bands must be passed top to
+   bottom, from one thread at a time. compressionLevel as in PngEncoder. */
+
+class PngStreamWriter
+{
+public:
+    PngStreamWriter(const QSize &size, int compressionLevel, QByteArray *bytes);
+    ~PngStreamWriter();
+
+    bool writeRows(const QImage &rows);
+
+    //writes the last IDAT and IEND chunk, fails unless all rows were written
+    bool finish();
+
+private:
+    bool deflateRows(const QByteArray &rows, int flush);
+
+    const QSize  m_size;
+    QByteArray * m_bytes;
+
+    std::unique_ptr<ZlibStream> m_stream;
+    bool m_valid {false};
+
+    PngRowFilter m_rowFilter;
+    int          m_rowsWritten {0};
+    QByteArray   m_idat;
+};
+
+#endif // PNGSTREAMWRITER_H
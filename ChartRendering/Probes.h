@@ -0,0 +1,50 @@
+#ifndef PROBES_H
+#define PROBES_H
+
+/* USDT probes of the provider "linechart", for perf, bpftrace and SystemTap on a
+   running service, e.g. the latency distribution of POST /line up to its response:
+
+       bpftrace -e 'usdt:./Linechart-Microservice:linechart:request__start { @start[arg0] = nsecs; }
+                    usdt:./Linechart-Microservice:linechart:request__done /@start[arg0]/
+                    { @us = hist((nsecs - @start[arg0]) / 1000); delete(@start[arg0]); }'
+
+   Built with CONFIG += usdt, which needs sys/sdt.h (systemtap-sdt-devel or
+   systemtap-sdt-dev). A probe compiles to a single nop and an ELF note, the
+   tracer patches it while attached; its arguments are evaluated anyway, so
+   probes only get values which are at hand. Without usdt they compile to nothing.
+
+   Request probes carry the request ID, the first 8 bytes of the request's span
+   ID, see TraceContext::requestId(); a render job carries the ID of the request
+   which queued it, 0 for the lazy renders of the idle renderer and handed off jobs.
+
+       request__start     id, route (char *), request bytes
+       request__dequeue   id
+       parse__done        id, request bytes
+       validate__done     id, points, series
+       store__done        id, stored spec bytes, stored
+       render__queued     id, joined a render in flight
+       fetch__done        id, chart bytes, cache hit
+       request__done      id, status code, response bytes
+       render__start      id, points
+       render__done       id, PNG bytes, rendered
+       render__published  id, stored chart bytes, saved */
+
+#ifdef LINECHART_USDT
+
+#include <sys/sdt.h>
+
+#define LINECHART_PROBE1(name, a1)                 DTRACE_PROBE1(linechart, name, a1)
+#define LINECHART_PROBE2(name, a1, a2)             DTRACE_PROBE2(linechart, name, a1, a2)
+#define LINECHART_PROBE3(name, a1, a2, a3)         DTRACE_PROBE3(linechart, name, a1, a2, a3)
+#define LINECHART_PROBE4(name, a1, a2, a3, a4)     DTRACE_PROBE4(linechart, name, a1, a2, a3, a4)
+
+#else
+
+#define LINECHART_PROBE1(name, a1)                 do {} while (false)
+#define LINECHART_PROBE2(name, a1, a2)             do {} while (false)
+#define LINECHART_PROBE3(name, a1, a2, a3)         do {} while (false)
+#define LINECHART_PROBE4(name, a1, a2, a3, a4)     do {} while (false)
+
+#endif
+
+#endif // PROBES_H
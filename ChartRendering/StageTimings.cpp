@@ -0,0 +1,126 @@
+#include "StageTimings.h"
+
+#include <algorithm>
+#include <chrono>
+
+StageTimings::StageTimings()
+{
+    m_nanoseconds.fill(-1);
+    m_startTimes.fill(-1);
+    m_endTimes.fill(-1);
+}
+
+void StageTimings::add(Stage stage, qint64 nanoseconds)
+{
+    const qint64 endTime {currentTime()};
+    add(stage, nanoseconds, endTime - std::max(nanoseconds, qint64{0}), endTime);
+}
+
+void StageTimings::add(Stage stage, qint64 nanoseconds, qint64 startTime, qint64 endTime)
+{
+    const int index {static_cast<int>(stage)};
+
+    m_nanoseconds[index] = std::max(m_nanoseconds.at(index), qint64{0}) + std::max(nanoseconds, qint64{0});
+    m_startTimes[index]  = m_startTimes.at(index) < 0 ? startTime : std::min(m_startTimes.at(index), startTime);
+    m_endTimes[index]    = std::max(m_endTimes.at(index), endTime);
+}
+
+qint64 StageTimings::nanoseconds(Stage stage) const
+{
+    return m_nanoseconds.at(static_cast<int>(stage));
+}
+
+qint64 StageTimings::startTime(Stage stage) const
+{
+    return m_startTimes.at(static_cast<int>(stage));
+}
+
+qint64 StageTimings::endTime(Stage stage) const
+{
+    return m_endTimes.at(static_cast<int>(stage));
+}
+
+void StageTimings::merge(const StageTimings &other)
+{
+    for (int stage {0}; stage < STAGE_COUNT; ++stage)
+    {
+        if (other.m_nanoseconds.at(stage) >= 0)
+            add(static_cast<Stage>(stage), other.m_nanoseconds.at(stage), other.m_startTimes.at(stage), other.m_endTimes.at(stage));
+    }
+}
+
+bool StageTimings::isEmpty() const
+{
+    return std::all_of(m_nanoseconds.begin(), m_nanoseconds.end(), [](qint64 nanoseconds) { return nanoseconds < 0; });
+}
+
+QByteArray StageTimings::toServerTiming() const
+{
+    QByteArrayList metrics;
+
+    for (int stage {0}; stage < STAGE_COUNT; ++stage)
+    {
+        if (m_nanoseconds.at(stage) >= 0)
+            metrics << QByteArray{stageName(static_cast<Stage>(stage))} + ";dur=" + QByteArray::number(m_nanoseconds.at(stage) / 1e6, 'f', 3);
+    }
+
+    return metrics.join(", ");
+}
+
+QJsonObject StageTimings::toJson() const
+{
+    QJsonObject timingsObject;
+
+    for (int stage {0}; stage < STAGE_COUNT; ++stage)
+    {
+        if (m_nanoseconds.at(stage) >= 0)
+            timingsObject.insert(stageName(static_cast<Stage>(stage)), m_nanoseconds.at(stage) / 1e6);
+    }
+
+    return timingsObject;
+}
+
+const char *StageTimings::stageName(Stage stage)
+{
+    switch (stage)
+    {
+    case Stage::QueueWait: return "queue";
+    case Stage::Parse:     return "parse";
+    case Stage::Validate:  return "validate";
+    case Stage::Build:     return "build";
+    case Stage::Layout:    return "layout";
+    case Stage::Raster:    return "raster";
+    case Stage::Encode:    return "encode";
+    case Stage::Store:     return "store";
+    case Stage::Fetch:     return "fetch";
+    }
+
+    return "unknown";
+}
+
+qint64 StageTimings::currentTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+StageClock::StageClock(StageTimings *timings) :
+    m_timings {timings}
+{
+    if (m_timings)
+        m_timer.start();
+}
+
+void StageClock::lap(StageTimings::Stage stage)
+{
+    if (!m_timings)
+        return;
+
+    m_timings->add(stage, m_timer.nsecsElapsed());
+    m_timer.restart();
+}
+
+void StageClock::restart()
+{
+    if (m_timings)
+        m_timer.restart();
+}
@@ -0,0 +1,85 @@
+#ifndef STAGETIMINGS_H
+#define STAGETIMINGS_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QByteArray>
+
+#include <array>
+
+/* Durations of the stages a request or render job went through, measured on
+   the monotonic clock of QElapsedTimer, and when each stage started and ended
+   on the wall clock, for trace spans. Stages that were never recorded are
+   left out of the Server-Timing header and the JSON form. Not thread-safe,
+   a StageTimings is filled by one thread at a time. */
+
+class StageTimings
+{
+public:
+    enum class Stage
+    {
+        QueueWait,
+        Parse,
+        Validate,
+        Build,
+        Layout,
+        Raster,
+        Encode,
+        Store,
+        Fetch
+    };
+
+    StageTimings();
+
+    //a stage which ended just now; adds up, if the stage is recorded more than once
+    void add(Stage stage, qint64 nanoseconds);
+
+    //a stage whose work is spread over startTime to endTime, e.g. deflating alongside other work
+    void add(Stage stage, qint64 nanoseconds, qint64 startTime, qint64 endTime);
+
+    //-1 if the stage was not recorded
+    qint64 nanoseconds(Stage stage) const;
+
+    //from the start of the first to the end of the last recording of the stage, -1 if it was not recorded
+    qint64 startTime(Stage stage) const;
+    qint64 endTime(Stage stage) const;
+
+    //adds every stage recorded in other
+    void merge(const StageTimings &other);
+
+    bool isEmpty() const;
+
+    //e.g. "queue;dur=0.042, parse;dur=1.310", durations in milliseconds
+    QByteArray toServerTiming() const;
+    QJsonObject toJson() const;
+
+    static const char *stageName(Stage stage);
+
+    //nanoseconds since the epoch, the clock of the start and end times
+    static qint64 currentTime();
+
+private:
+    static constexpr int STAGE_COUNT {static_cast<int>(Stage::Fetch) + 1};
+
+    std::array<qint64, STAGE_COUNT> m_nanoseconds;
+    std::array<qint64, STAGE_COUNT> m_startTimes;
+    std::array<qint64, STAGE_COUNT> m_endTimes;
+};
+
+//times consecutive stages: each lap() books the time since the previous lap, a null timings makes it a no-op
+class StageClock
+{
+public:
+    explicit StageClock(StageTimings *timings);
+
+    void lap(StageTimings::Stage stage);
+
+    //discards the time since the previous lap, e.g. a wait that is accounted for elsewhere
+    void restart();
+
+private:
+    StageTimings * const m_timings;
+    QElapsedTimer        m_timer;
+};
+
+#endif // STAGETIMINGS_H
@@ -0,0 +1,32 @@
+#ifndef ZLIBBACKEND_H
+#define ZLIBBACKEND_H
+
+/* The deflate library behind PngStreamWriter and ParallelPngWriter. With
+   CONFIG+=zlibng the native zlib-ng API is used, which keeps the zlib names
+   with a zng_ prefix, otherwise the system zlib. Only this header may include
+   either of them. */
+
+#ifdef LINECHART_ZLIBNG
+
+#include <zlib-ng.h>
+
+struct ZlibStream : zng_stream {};
+
+#define deflateInit2          zng_deflateInit2
+#define deflateSetDictionary  zng_deflateSetDictionary
+#define deflateBound          zng_deflateBound
+#define deflate               zng_deflate
+#define deflateEnd            zng_deflateEnd
+#define crc32                 zng_crc32
+#define adler32               zng_adler32
+#define adler32_combine       zng_adler32_combine
+
+#else
+
+#include <zlib.h>
+
+struct ZlibStream : z_stream {};
+
+#endif
+
+#endif // ZLIBBACKEND_H
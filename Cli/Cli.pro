@@ -0,0 +1,15 @@
+TARGET = Linechart-Batch
+
+QT = core charts gui
+
+CONFIG += c++17 cmdline
+
+include(../ChartRendering/ChartRendering.pri)
+
+SOURCES += \
+        main.cpp
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
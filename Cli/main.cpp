@@ -0,0 +1,53 @@
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QThread>
+#include <QDebug>
+
+#include "ChartRendering.h"
+
+int main(int argc, char *argv[])
+{
+    selectOffscreenPlatform();
+
+    QApplication app {argc, argv};
+
+    QCoreApplication::setApplicationName("LineChart-Batch");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser commandlineParser;
+    commandlineParser.addHelpOption();
+    commandlineParser.addVersionOption();
+    commandlineParser.setApplicationDescription("Renders every /line record of a JSONL file into PNG files.");
+
+    const QCommandLineOption outOption         {"out",         "Output <directory> for the charts.", "directory"};
+    const QCommandLineOption threadsOption     {"threads",     "Number of render <threads>.", "threads", QString::number(QThread::idealThreadCount())};
+    const QCommandLineOption compressionOption {"compression", "PNG compression <level> from 0 to 9.", "level", "-1"};
+
+    commandlineParser.addPositionalArgument("file", "The JSONL file with one /line record per line.");
+    commandlineParser.addOption(outOption);
+    commandlineParser.addOption(threadsOption);
+    commandlineParser.addOption(compressionOption);
+    commandlineParser.process(app);
+
+    if (commandlineParser.positionalArguments().size() != 1)
+        commandlineParser.showHelp(-100);
+
+    if (!commandlineParser.isSet(outOption))
+        commandlineParser.showHelp(-101);
+
+    const BatchRenderer batchRenderer
+    {
+        commandlineParser.value(outOption),
+        commandlineParser.value(threadsOption).toInt(),
+        commandlineParser.value(compressionOption).toInt()
+    };
+
+    BatchRenderer::Report report;
+
+    if (!batchRenderer.run(commandlineParser.positionalArguments().first(), &report))
+        commandlineParser.showHelp(-102);
+
+    qInfo().noquote() << BatchRenderer::formatReport(report);
+    return report.failed == 0 ? 0 : 1;
+}
@@ -1,19 +1,20 @@
-QT = core httpserver charts gui
+TEMPLATE = subdirs
 
-CONFIG += c++17 cmdline
+# ChartRendering is a static library with the parser, series table, renderer, encoder and store,
+# Server, Cli and Benchmark are thin executables on top of it.
+#
+# Faster PNG codecs are opt-in, see ChartRendering/Codecs.pri:
+#   qmake CONFIG+=zlibng CONFIG+=libdeflate CONFIG+=spng
+# Linechart-Benchmark compares the encoders that were built.
+# On Linux, CONFIG+=io_uring moves the chart file I/O of the server onto io_uring.
+# CONFIG+=usdt compiles in USDT probes for perf, bpftrace and SystemTap, see ChartRendering/Probes.h.
 
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-        main.cpp
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
-
-HEADERS += \
-    CommonUtilities/CommonUtilities.h
+SUBDIRS += \
+    ChartRendering \
+    Server \
+    Cli \
+    Benchmark
 
+Server.depends    = ChartRendering
+Cli.depends       = ChartRendering
+Benchmark.depends = ChartRendering
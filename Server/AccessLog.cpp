@@ -0,0 +1,156 @@
+#include "AccessLog.h"
+
+#include <QRandomGenerator>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+
+#include <algorithm>
+
+namespace
+{
+    constexpr unsigned long DrainInterval {50};
+}
+
+AccessLog::AccessLog(const QString &filename, qint64 capacity, double sampling, int sampleAbove) :
+    m_filename {filename},
+    m_ring {filename.isEmpty() ? 2 : capacity},
+    m_sampling {std::clamp(sampling, 0.0, 1.0)},
+    m_sampleAbove {std::max(sampleAbove, 0)}
+{
+    if (!isEnabled())
+        return;
+
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->start();
+}
+
+AccessLog::~AccessLog()
+{
+    if (!m_thread)
+        return;
+
+    m_stopping.store(true);
+    m_thread->wait();
+}
+
+void AccessLog::setSampling(double sampling, int sampleAbove)
+{
+    m_sampling.store(std::clamp(sampling, 0.0, 1.0));
+    m_sampleAbove.store(std::max(sampleAbove, 0));
+}
+
+bool AccessLog::isEnabled() const
+{
+    return !m_filename.isEmpty();
+}
+
+void AccessLog::append(const Entry &entry)
+{
+    if (!isEnabled() || !sampled())
+        return;
+
+    if (!m_ring.tryPush(entry))
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool AccessLog::sampled()
+{
+    const int sampleAbove {m_sampleAbove.load(std::memory_order_relaxed)};
+
+    if (sampleAbove > 0)
+    {
+        const qint64 second {QDateTime::currentSecsSinceEpoch()};
+        qint64 window {m_window.load(std::memory_order_relaxed)};
+
+        //the first request of a new second resets the count, a few racing requests may be counted in the old one
+        if (window != second && m_window.compare_exchange_strong(window, second, std::memory_order_relaxed))
+            m_windowCount.store(0, std::memory_order_relaxed);
+
+        if (m_windowCount.fetch_add(1, std::memory_order_relaxed) < sampleAbove)
+            return true;
+    }
+
+    const double sampling {m_sampling.load(std::memory_order_relaxed)};
+
+    return sampling >= 1.0 || QRandomGenerator::global()->generateDouble() < sampling;
+}
+
+void AccessLog::run()
+{
+    QFile file {m_filename};
+
+    //the ring is drained anyway, so a broken log never fills it up
+    if (!file.open(QIODevice::OpenModeFlag::WriteOnly | QIODevice::OpenModeFlag::Append))
+        qWarning().noquote() << QString{"The access log %0 could not be opened: %1"}.arg(m_filename, file.errorString());
+
+    while (true)
+    {
+        //read before draining, so everything appended before the destructor is written
+        const bool stopping {m_stopping.load()};
+
+        QByteArray lines;
+        Entry entry;
+
+        while (m_ring.tryPop(&entry))
+            lines += toJsonLine(entry);
+
+        const qint64 dropped {m_dropped.exchange(0)};
+
+        if (dropped > 0)
+        {
+            lines += QJsonDocument{QJsonObject
+            {
+                {"Time",    QDateTime::currentDateTimeUtc().toString(Qt::DateFormat::ISODateWithMs)},
+                {"Dropped", dropped}
+            }}.toJson(QJsonDocument::JsonFormat::Compact) + '\n';
+        }
+
+        if (!lines.isEmpty() && file.isOpen())
+        {
+            file.write(lines);
+            file.flush();
+        }
+
+        if (stopping)
+            return;
+
+        QThread::msleep(DrainInterval);
+    }
+}
+
+QByteArray AccessLog::toJsonLine(const Entry &entry)
+{
+    QJsonObject entryObject
+    {
+        {"Time",          QDateTime::fromMSecsSinceEpoch(entry.time / 1000000).toUTC().toString(Qt::DateFormat::ISODateWithMs)},
+        {"Route",         entry.route},
+        {"Status",        entry.status},
+        {"RequestBytes",  entry.requestBytes},
+        {"ResponseBytes", entry.responseBytes},
+        {"CacheHit",      entry.cacheHit}
+    };
+
+    if (!entry.uuid.isNull())
+        entryObject.insert("Uuid", entry.uuid.toString(QUuid::StringFormat::WithoutBraces));
+
+    if (entry.pointCount >= 0)
+        entryObject.insert("Points", entry.pointCount);
+
+    if (entry.seriesCount >= 0)
+        entryObject.insert("Series", entry.seriesCount);
+
+    StageTimings timings {entry.timings};
+    timings.merge(entry.renderTimings);
+
+    if (!timings.isEmpty())
+        entryObject.insert("Timings", timings.toJson());
+
+    //correlates the line with the spans of the request
+    if (entry.trace.isValid())
+        entryObject.insert("TraceId", entry.trace.traceIdString());
+
+    return QJsonDocument{entryObject}.toJson(QJsonDocument::JsonFormat::Compact) + '\n';
+}
@@ -0,0 +1,77 @@
+#ifndef ACCESSLOG_H
+#define ACCESSLOG_H
+
+#include <QScopedPointer>
+#include <QByteArray>
+#include <QThread>
+#include <QString>
+#include <QUuid>
+
+#include <atomic>
+
+#include "StageTimings.h"
+#include "SpanExporter.h"
+#include "MpscRing.h"
+
+/* Structured access log, one JSON-object per line. Request threads only copy
+   an Entry into a lock-free ring, a background thread drains it every few
+   milliseconds, serializes the entries and appends them to the file, so
+   logging never waits for the disk or a lock. When the ring is full, entries
+   are dropped and the writer reports how many. Above sampleAbove requests per
+   second only a sampling fraction of the requests is logged, 0 samples all. */
+
+class AccessLog
+{
+public:
+    struct Entry
+    {
+        qint64       time          {0};
+        const char  *route         {""};
+        QUuid        uuid;
+        int          status        {0};
+        qint64       requestBytes  {0};
+        qint64       responseBytes {0};
+        int          pointCount    {-1};
+        int          seriesCount   {-1};
+        bool         cacheHit      {false};
+        StageTimings timings;
+        TraceContext trace;
+
+        //stages of the render job whose chart the request returned, reported along with its own
+        StageTimings renderTimings;
+    };
+
+    //an empty filename disables the log
+    AccessLog(const QString &filename, qint64 capacity, double sampling, int sampleAbove);
+    ~AccessLog();
+
+    void setSampling(double sampling, int sampleAbove);
+
+    bool isEnabled() const;
+
+    //never blocks, see above when an entry is not logged
+    void append(const Entry &entry);
+
+private:
+    void run();
+    bool sampled();
+
+    static QByteArray toJsonLine(const Entry &entry);
+
+    const QString   m_filename;
+    MpscRing<Entry> m_ring;
+
+    std::atomic<double> m_sampling;
+    std::atomic<int>    m_sampleAbove;
+
+    //requests in the current second, for sampleAbove
+    std::atomic<qint64> m_window      {0};
+    std::atomic<int>    m_windowCount {0};
+
+    std::atomic<qint64> m_dropped  {0};
+    std::atomic<bool>   m_stopping {false};
+
+    QScopedPointer<QThread> m_thread;
+};
+
+#endif // ACCESSLOG_H
@@ -0,0 +1,144 @@
+#include "CallbackDispatcher.h"
+
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QMutexLocker>
+#include <QTimer>
+#include <QDebug>
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    //upper bound of the backoff between two attempts, in ms
+    constexpr qint64 MaxRetryBackoff {300000};
+}
+
+CallbackDispatcher::CallbackDispatcher(int queueLimit, int maxRetries, int retryInterval, QObject *parent) :
+    QObject {parent}
+{
+    setLimits(queueLimit, maxRetries, retryInterval);
+}
+
+void CallbackDispatcher::setLimits(int queueLimit, int maxRetries, int retryInterval)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    m_queueLimit    = std::max(queueLimit, 1);
+    m_maxRetries    = std::max(maxRetries, 0);
+    m_retryInterval = std::max(retryInterval, 1);
+}
+
+bool CallbackDispatcher::enqueue(const QUrl &url, const QJsonObject &payload)
+{
+    {
+        const QMutexLocker locker {&m_mutex};
+
+        //queued, in flight and waiting for a retry all count against the limit
+        if (m_pending >= m_queueLimit)
+            return false;
+
+        m_queue.enqueue({url, payload, 0});
+        ++m_pending;
+    }
+
+    QMetaObject::invokeMethod(this, &CallbackDispatcher::dispatchPending, Qt::QueuedConnection);
+    return true;
+}
+
+int CallbackDispatcher::pendingCount() const
+{
+    const QMutexLocker locker {&m_mutex};
+    return m_pending;
+}
+
+bool CallbackDispatcher::isValidCallbackUrl(const QUrl &url)
+{
+    if (!url.isValid() || url.host().isEmpty())
+        return false;
+
+    return url.scheme() == "http" || url.scheme() == "https";
+}
+
+void CallbackDispatcher::dispatchPending()
+{
+    while (m_inFlight < MAX_IN_FLIGHT)
+    {
+        Delivery delivery;
+
+        {
+            const QMutexLocker locker {&m_mutex};
+
+            if (m_queue.isEmpty())
+                return;
+
+            delivery = m_queue.dequeue();
+        }
+
+        deliver(delivery);
+    }
+}
+
+void CallbackDispatcher::deliver(const Delivery &delivery)
+{
+    QNetworkRequest request {delivery.url};
+    request.setHeader(QNetworkRequest::KnownHeaders::ContentTypeHeader, "application/json");
+    request.setTransferTimeout(10000);
+
+    QNetworkReply * const reply {m_networkAccessManager.post(request, QJsonDocument{delivery.payload}.toJson(QJsonDocument::JsonFormat::Compact))};
+    ++m_inFlight;
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, delivery]()
+    {
+        const int statusCode {reply->attribute(QNetworkRequest::Attribute::HttpStatusCodeAttribute).toInt()};
+        const bool delivered {reply->error() == QNetworkReply::NetworkError::NoError && statusCode >= 200 && statusCode < 300};
+
+        reply->deleteLater();
+        --m_inFlight;
+
+        finish(delivery, delivered);
+        dispatchPending();
+    });
+}
+
+void CallbackDispatcher::finish(const Delivery &delivery, bool delivered)
+{
+    int maxRetries    {0};
+    int retryInterval {0};
+
+    {
+        const QMutexLocker locker {&m_mutex};
+
+        maxRetries    = m_maxRetries;
+        retryInterval = m_retryInterval;
+    }
+
+    if (!delivered && delivery.attempt < maxRetries)
+    {
+        const qint64 backoff {std::min(qint64{retryInterval} << std::min(delivery.attempt, 10), MaxRetryBackoff)};
+
+        //half of the backoff is random, so callbacks which failed together do not retry in lockstep
+        const qint64 jitteredBackoff {backoff / 2 + QRandomGenerator::global()->bounded(backoff / 2 + 1)};
+
+        QTimer::singleShot(std::chrono::milliseconds{jitteredBackoff}, this, [this, delivery]()
+        {
+            {
+                const QMutexLocker locker {&m_mutex};
+                m_queue.enqueue({delivery.url, delivery.payload, delivery.attempt + 1});
+            }
+
+            dispatchPending();
+        });
+
+        return;
+    }
+
+    if (!delivered)
+        qWarning() << "Callback to" << delivery.url.toString() << "failed after" << delivery.attempt + 1 << "attempts.";
+
+    const QMutexLocker locker {&m_mutex};
+    --m_pending;
+}
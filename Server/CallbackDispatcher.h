@@ -0,0 +1,58 @@
+#ifndef CALLBACKDISPATCHER_H
+#define CALLBACKDISPATCHER_H
+
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QJsonObject>
+#include <QMutex>
+#include <QQueue>
+#include <QUrl>
+
+/* POSTs result notifications to the CallbackUrl of a client.
+   enqueue() may be called from any thread, the requests themselves are sent
+   from the thread the dispatcher lives in. The queue is bounded, failed
+   deliveries are retried up to maxRetries times with exponential backoff. */
+
+class CallbackDispatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CallbackDispatcher(int queueLimit, int maxRetries, int retryInterval, QObject *parent = nullptr);
+
+    bool enqueue(const QUrl &url, const QJsonObject &payload);
+
+    //applies to deliveries which are enqueued or retried from now on
+    void setLimits(int queueLimit, int maxRetries, int retryInterval);
+
+    int pendingCount() const;
+
+    static bool isValidCallbackUrl(const QUrl &url);
+
+private:
+    struct Delivery
+    {
+        QUrl        url;
+        QJsonObject payload;
+        int         attempt {0};
+    };
+
+    void dispatchPending();
+    void deliver(const Delivery &delivery);
+    void finish(const Delivery &delivery, bool delivered);
+
+    static constexpr int MAX_IN_FLIGHT {16};
+
+    QNetworkAccessManager m_networkAccessManager;
+
+    mutable QMutex  m_mutex;
+    QQueue<Delivery> m_queue;
+    int             m_pending  {0};
+    int             m_inFlight {0};
+
+    int m_queueLimit;
+    int m_maxRetries;
+    int m_retryInterval;
+};
+
+#endif // CALLBACKDISPATCHER_H
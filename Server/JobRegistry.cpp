@@ -0,0 +1,187 @@
+#include "JobRegistry.h"
+
+#include <QDeadlineTimer>
+#include <QMutexLocker>
+
+void JobRegistry::enqueue(const QUuid &uuid, const QByteArray &payload)
+{
+    Stripe &jobStripe {stripe(uuid)};
+
+    const QMutexLocker locker {&jobStripe.mutex};
+    jobStripe.entries.insert(uuid, {State::Queued, m_nextTicket.fetch_add(1), {}, {}, payload});
+}
+
+bool JobRegistry::start(const QUuid &uuid)
+{
+    Stripe &jobStripe {stripe(uuid)};
+
+    {
+        const QMutexLocker locker {&jobStripe.mutex};
+
+        const auto entry {jobStripe.entries.find(uuid)};
+
+        if (entry == jobStripe.entries.end() || entry->state != State::Queued)
+            return false;
+
+        entry->state = State::Rendering;
+        entry->payload.clear();
+    }
+
+    m_startedTickets.fetch_add(1);
+    jobStripe.changed.wakeAll();
+
+    return true;
+}
+
+void JobRegistry::finish(const QUuid &uuid, bool succeeded, const QString &message, const StageTimings &timings)
+{
+    Stripe &jobStripe {stripe(uuid)};
+
+    {
+        const QMutexLocker locker {&jobStripe.mutex};
+
+        const auto entry {jobStripe.entries.find(uuid)};
+
+        if (entry == jobStripe.entries.end())
+            return;
+
+        entry->state    = succeeded ? State::Done : State::Failed;
+        entry->message  = message;
+        entry->finished = QDateTime::currentDateTimeUtc();
+        entry->timings  = timings;
+    }
+
+    m_finishedTickets.fetch_add(1);
+    jobStripe.changed.wakeAll();
+}
+
+QVector<QByteArray> JobRegistry::takeQueued()
+{
+    QVector<QByteArray> payloads;
+
+    for (Stripe &jobStripe : m_stripes)
+    {
+        {
+            const QMutexLocker locker {&jobStripe.mutex};
+
+            jobStripe.entries.removeIf([&payloads](const QHash<QUuid, Entry>::iterator entry)
+            {
+                if (entry->state != State::Queued)
+                    return false;
+
+                payloads << entry->payload;
+                return true;
+            });
+        }
+
+        //waiting long-polls see the job disappear
+        jobStripe.changed.wakeAll();
+    }
+
+    m_startedTickets.fetch_add(static_cast<quint64>(payloads.size()));
+    m_finishedTickets.fetch_add(static_cast<quint64>(payloads.size()));
+
+    return payloads;
+}
+
+std::optional<JobRegistry::Status> JobRegistry::status(const QUuid &uuid) const
+{
+    const Stripe &jobStripe {stripe(uuid)};
+
+    const QMutexLocker locker {&jobStripe.mutex};
+
+    const auto entry {jobStripe.entries.constFind(uuid)};
+
+    if (entry == jobStripe.entries.constEnd())
+        return std::nullopt;
+
+    return toStatus(*entry);
+}
+
+std::optional<JobRegistry::Status> JobRegistry::waitForCompletion(const QUuid &uuid, int timeout) const
+{
+    const Stripe &jobStripe {stripe(uuid)};
+    const QDeadlineTimer deadline {timeout};
+
+    QMutexLocker locker {&jobStripe.mutex};
+
+    while (true)
+    {
+        const auto entry {jobStripe.entries.constFind(uuid)};
+
+        if (entry == jobStripe.entries.constEnd())
+            return std::nullopt;
+
+        if (entry->state == State::Done || entry->state == State::Failed || deadline.hasExpired())
+            return toStatus(*entry);
+
+        jobStripe.changed.wait(&jobStripe.mutex, deadline);
+    }
+}
+
+qint64 JobRegistry::queuedCount() const
+{
+    const quint64 started {m_startedTickets.load()};
+    const quint64 handedOut {m_nextTicket.load()};
+
+    return handedOut > started ? static_cast<qint64>(handedOut - started) : 0;
+}
+
+qint64 JobRegistry::activeCount() const
+{
+    const quint64 finished {m_finishedTickets.load()};
+    const quint64 handedOut {m_nextTicket.load()};
+
+    return handedOut > finished ? static_cast<qint64>(handedOut - finished) : 0;
+}
+
+void JobRegistry::prune(qint64 retention)
+{
+    const QDateTime cutoff {QDateTime::currentDateTimeUtc().addSecs(-retention)};
+
+    for (Stripe &jobStripe : m_stripes)
+    {
+        const QMutexLocker locker {&jobStripe.mutex};
+
+        jobStripe.entries.removeIf([&cutoff](const QHash<QUuid, Entry>::iterator entry)
+        {
+            return entry->finished.isValid() && entry->finished < cutoff;
+        });
+    }
+}
+
+QString JobRegistry::stateName(State state)
+{
+    switch (state)
+    {
+        case State::Queued:    return "queued";
+        case State::Rendering: return "rendering";
+        case State::Done:      return "done";
+        case State::Failed:    return "failed";
+    }
+
+    return {};
+}
+
+JobRegistry::Stripe &JobRegistry::stripe(const QUuid &uuid)
+{
+    return m_stripes[qHash(uuid) % STRIPE_COUNT];
+}
+
+const JobRegistry::Stripe &JobRegistry::stripe(const QUuid &uuid) const
+{
+    return m_stripes[qHash(uuid) % STRIPE_COUNT];
+}
+
+JobRegistry::Status JobRegistry::toStatus(const Entry &entry) const
+{
+    Status status {entry.state, 0, entry.message, entry.timings};
+
+    if (entry.state == State::Queued)
+    {
+        const quint64 started {m_startedTickets.load()};
+        status.queuePosition = entry.ticket >= started ? static_cast<qint64>(entry.ticket - started) + 1 : 1;
+    }
+
+    return status;
+}
@@ -0,0 +1,103 @@
+#ifndef JOBREGISTRY_H
+#define JOBREGISTRY_H
+
+#include <QWaitCondition>
+#include <QDateTime>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QMutex>
+#include <QHash>
+#include <QUuid>
+
+#include <optional>
+#include <atomic>
+#include <array>
+
+#include "StageTimings.h"
+
+/* In-memory state of all render jobs, keyed by the chart UUID.
+   The map is split into stripes with their own mutex, so concurrent
+   status requests and render threads rarely contend on the same lock.
+   Queue positions are derived from a ticket handed out on enqueue and
+   the number of jobs the render pool has started so far. */
+
+class JobRegistry
+{
+public:
+    enum class State
+    {
+        Queued,
+        Rendering,
+        Done,
+        Failed
+    };
+
+    struct Status
+    {
+        State   state         {State::Queued};
+        qint64  queuePosition {0};
+        QString message;
+
+        //the render stages of a finished job
+        StageTimings timings;
+    };
+
+    //payload is kept while the job is queued, so it can be handed off on shutdown
+    void enqueue(const QUuid &uuid, const QByteArray &payload = {});
+
+    //false if the job is no longer queued, e.g. because it was handed off
+    bool start(const QUuid &uuid);
+    void finish(const QUuid &uuid, bool succeeded, const QString &message = {}, const StageTimings &timings = {});
+
+    //removes all jobs which did not start yet and returns their payloads
+    QVector<QByteArray> takeQueued();
+
+    std::optional<Status> status(const QUuid &uuid) const;
+
+    //blocks until the job is done or failed, or until timeout milliseconds have passed
+    std::optional<Status> waitForCompletion(const QUuid &uuid, int timeout) const;
+
+    qint64 queuedCount() const;
+
+    //queued and rendering jobs
+    qint64 activeCount() const;
+
+    //removes finished jobs which are older than retention seconds
+    void prune(qint64 retention);
+
+    static QString stateName(State state);
+
+private:
+    struct Entry
+    {
+        State        state  {State::Queued};
+        quint64      ticket {0};
+        QString      message;
+        QDateTime    finished;
+        QByteArray   payload;
+        StageTimings timings;
+    };
+
+    struct Stripe
+    {
+        mutable QMutex         mutex;
+        mutable QWaitCondition changed;
+        QHash<QUuid, Entry>    entries;
+    };
+
+    static constexpr int STRIPE_COUNT {16};
+
+    Stripe &stripe(const QUuid &uuid);
+    const Stripe &stripe(const QUuid &uuid) const;
+
+    Status toStatus(const Entry &entry) const;
+
+    std::array<Stripe, STRIPE_COUNT> m_stripes;
+
+    std::atomic<quint64> m_nextTicket      {0};
+    std::atomic<quint64> m_startedTickets  {0};
+    std::atomic<quint64> m_finishedTickets {0};
+};
+
+#endif // JOBREGISTRY_H
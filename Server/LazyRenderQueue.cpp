@@ -0,0 +1,19 @@
+#include "LazyRenderQueue.h"
+
+void LazyRenderQueue::enqueue(const QUuid &uuid)
+{
+    const QMutexLocker locker {&m_mutex};
+    m_uuids.enqueue(uuid);
+}
+
+QVector<QUuid> LazyRenderQueue::take(int count)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    QVector<QUuid> uuids;
+
+    while (uuids.size() < count && !m_uuids.isEmpty())
+        uuids << m_uuids.dequeue();
+
+    return uuids;
+}
@@ -0,0 +1,26 @@
+#ifndef LAZYRENDERQUEUE_H
+#define LAZYRENDERQUEUE_H
+
+#include <QVector>
+#include <QMutex>
+#include <QQueue>
+#include <QUuid>
+
+/* The lazily stored charts in order of their POST, from which the idle
+   renderer takes the next ones while the render pool has nothing to do.
+   Only filled while idle rendering is enabled, it is off by default.
+   Entries are not removed when a chart is fetched, expires or is evicted,
+   the taker checks the index and skips charts that are no longer a spec. */
+
+class LazyRenderQueue
+{
+public:
+    void enqueue(const QUuid &uuid);
+    QVector<QUuid> take(int count);
+
+private:
+    QMutex m_mutex;
+    QQueue<QUuid> m_uuids;
+};
+
+#endif // LAZYRENDERQUEUE_H
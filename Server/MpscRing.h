@@ -0,0 +1,102 @@
+#ifndef MPSCRING_H
+#define MPSCRING_H
+
+#include <QtMath>
+
+#include <algorithm>
+#include <memory>
+#include <atomic>
+
+/* Bounded lock-free queue for many producers and a single consumer, after
+   Dmitry Vyukov's bounded queue: every slot carries a sequence number that
+   tells producers whether it is free and the consumer whether it is filled.
+   Producers claim a slot with one compare-and-swap on the tail and never
+   block or allocate, a full ring makes tryPush() fail instead of waiting.
+   T should be cheap to copy, it is copied into and out of its slot. */
+
+template <typename T>
+class MpscRing
+{
+public:
+    //capacity is rounded up to a power of two
+    explicit MpscRing(qint64 capacity) :
+        m_capacity {static_cast<quint64>(qNextPowerOfTwo(static_cast<quint64>(std::max(capacity, qint64{2}) - 1)))},
+        m_slots {new Slot[m_capacity]}
+    {
+        for (quint64 position {0}; position < m_capacity; ++position)
+            m_slots[position].sequence.store(position, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing &) = delete;
+    MpscRing &operator=(const MpscRing &) = delete;
+
+    //any thread, false if the ring is full
+    bool tryPush(const T &value)
+    {
+        quint64 position {m_tail.load(std::memory_order_relaxed)};
+
+        while (true)
+        {
+            Slot &slot {m_slots[position & (m_capacity - 1)]};
+
+            const quint64 sequence {slot.sequence.load(std::memory_order_acquire)};
+            const qint64 difference {static_cast<qint64>(sequence - position)};
+
+            if (difference == 0)
+            {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                //the consumer has not taken the value a full lap ago yet
+                return false;
+            }
+            else
+            {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //the consumer thread only, false if the ring is empty
+    bool tryPop(T *value)
+    {
+        Slot &slot {m_slots[m_head & (m_capacity - 1)]};
+
+        if (slot.sequence.load(std::memory_order_acquire) != m_head + 1)
+            return false;
+
+        *value = slot.value;
+        slot.sequence.store(m_head + m_capacity, std::memory_order_release);
+        ++m_head;
+
+        return true;
+    }
+
+    qint64 capacity() const
+    {
+        return static_cast<qint64>(m_capacity);
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<quint64> sequence {0};
+        T value;
+    };
+
+    const quint64 m_capacity;
+    const std::unique_ptr<Slot[]> m_slots;
+
+    //producers and consumer write to different cache lines
+    alignas(64) std::atomic<quint64> m_tail {0};
+    alignas(64) quint64 m_head {0};
+};
+
+#endif // MPSCRING_H
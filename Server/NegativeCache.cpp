@@ -0,0 +1,59 @@
+#include "NegativeCache.h"
+
+#include <algorithm>
+
+NegativeCache::NegativeCache(qint64 ttl, int capacity)
+{
+    m_clock.start();
+    setLimits(ttl, capacity);
+}
+
+void NegativeCache::setLimits(qint64 ttl, int capacity)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    m_ttl      = std::max(ttl, qint64{0});
+    m_capacity = std::max(capacity, 0);
+
+    if (m_expiries.size() > m_capacity)
+        m_expiries.clear();
+}
+
+void NegativeCache::insert(const QUuid &uuid)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    if (m_ttl == 0 || m_capacity == 0)
+        return;
+
+    const qint64 now {m_clock.elapsed()};
+
+    if (m_expiries.size() >= m_capacity)
+    {
+        m_expiries.removeIf([now](const QHash<QUuid, qint64>::iterator &entry)
+        {
+            return entry.value() <= now;
+        });
+
+        if (m_expiries.size() >= m_capacity)
+            m_expiries.clear();
+    }
+
+    m_expiries.insert(uuid, now + m_ttl);
+}
+
+void NegativeCache::remove(const QUuid &uuid)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    m_expiries.remove(uuid);
+}
+
+bool NegativeCache::contains(const QUuid &uuid) const
+{
+    const QMutexLocker locker {&m_mutex};
+
+    const auto entry {m_expiries.constFind(uuid)};
+
+    return entry != m_expiries.constEnd() && entry.value() > m_clock.elapsed();
+}
@@ -0,0 +1,35 @@
+#ifndef NEGATIVECACHE_H
+#define NEGATIVECACHE_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QHash>
+#include <QUuid>
+
+/* Remembers for a short time which UUIDs were looked up and not found, so
+   repeated hits of stale links and scrapers are answered from memory. Holds
+   at most capacity entries; when full, expired entries are dropped and if
+   that is not enough, the whole cache is cleared. */
+
+class NegativeCache
+{
+public:
+    NegativeCache(qint64 ttl, int capacity);
+
+    void setLimits(qint64 ttl, int capacity);
+
+    void insert(const QUuid &uuid);
+    void remove(const QUuid &uuid);
+    bool contains(const QUuid &uuid) const;
+
+private:
+    mutable QMutex m_mutex;
+
+    qint64 m_ttl;
+    int    m_capacity;
+
+    QElapsedTimer m_clock;
+    QHash<QUuid, qint64> m_expiries;
+};
+
+#endif // NEGATIVECACHE_H
@@ -0,0 +1,122 @@
+#include "ReadinessMonitor.h"
+
+#include <QMutexLocker>
+#include <QStorageInfo>
+#include <QDateTime>
+
+#include <algorithm>
+
+ReadinessMonitor::ReadinessMonitor(const QString &directory, const Thresholds &thresholds, int warmUpRenders) :
+    m_directory      {directory},
+    m_pendingWarmUps {warmUpRenders},
+    m_thresholds     {thresholds}
+{
+
+}
+
+void ReadinessMonitor::setThresholds(const Thresholds &thresholds)
+{
+    const QMutexLocker locker {&m_mutex};
+    m_thresholds = thresholds;
+}
+
+void ReadinessMonitor::warmUpFinished()
+{
+    m_pendingWarmUps.fetch_sub(1);
+}
+
+void ReadinessMonitor::recordRender(bool succeeded)
+{
+    const qint64 second {QDateTime::currentSecsSinceEpoch()};
+
+    const QMutexLocker locker {&m_mutex};
+
+    Bucket &bucket {m_buckets[static_cast<std::size_t>(second % BUCKET_COUNT)]};
+
+    if (bucket.second != second)
+        bucket = {second, 0, 0};
+
+    if (succeeded)
+        ++bucket.succeeded;
+    else
+        ++bucket.failed;
+}
+
+void ReadinessMonitor::beginShutdown()
+{
+    m_shuttingDown.store(true);
+}
+
+bool ReadinessMonitor::isShuttingDown() const
+{
+    return m_shuttingDown.load();
+}
+
+QStringList ReadinessMonitor::check(qint64 queueDepth, QJsonObject *details) const
+{
+    Thresholds thresholds;
+
+    {
+        const QMutexLocker locker {&m_mutex};
+        thresholds = m_thresholds;
+    }
+
+    QStringList reasons;
+
+    if (m_shuttingDown.load())
+        reasons << "The service is shutting down.";
+
+    if (m_pendingWarmUps.load() > 0)
+        reasons << "The warm-up renders are not finished yet.";
+
+    if (queueDepth > thresholds.maxQueueDepth)
+        reasons << QString{"The render queue depth %0 exceeds %1."}.arg(queueDepth).arg(thresholds.maxQueueDepth);
+
+    const QStorageInfo storageInfo {m_directory};
+    const qint64 diskFree {storageInfo.isValid() ? storageInfo.bytesAvailable() : 0};
+
+    if (diskFree < thresholds.minDiskFree)
+        reasons << QString{"Only %0 bytes are free below the image path, at least %1 are required."}.arg(diskFree).arg(thresholds.minDiskFree);
+
+    qint64 samples {0};
+    const double rate {errorRate(thresholds.errorWindow, &samples)};
+
+    if (samples >= MINIMUM_ERROR_SAMPLES && rate > thresholds.maxErrorRate)
+        reasons << QString{"The render error rate %0 exceeds %1."}.arg(rate).arg(thresholds.maxErrorRate);
+
+    if (details)
+    {
+        details->insert("QueueDepth", queueDepth);
+        details->insert("DiskFree",   diskFree);
+        details->insert("ErrorRate",  rate);
+    }
+
+    return reasons;
+}
+
+double ReadinessMonitor::errorRate(int errorWindow, qint64 *samples) const
+{
+    const qint64 window {std::clamp<qint64>(errorWindow, 1, BUCKET_COUNT)};
+    const qint64 oldestSecond {QDateTime::currentSecsSinceEpoch() - window};
+
+    qint64 succeeded {0};
+    qint64 failed    {0};
+
+    {
+        const QMutexLocker locker {&m_mutex};
+
+        for (const Bucket &bucket : m_buckets)
+        {
+            if (bucket.second <= oldestSecond)
+                continue;
+
+            succeeded += bucket.succeeded;
+            failed    += bucket.failed;
+        }
+    }
+
+    if (samples)
+        *samples = succeeded + failed;
+
+    return succeeded + failed > 0 ? static_cast<double>(failed) / static_cast<double>(succeeded + failed) : 0;
+}
@@ -0,0 +1,64 @@
+#ifndef READINESSMONITOR_H
+#define READINESSMONITOR_H
+
+#include <QStringList>
+#include <QJsonObject>
+#include <QString>
+#include <QMutex>
+
+#include <atomic>
+#include <array>
+
+/* Decides whether this instance should receive traffic: the warm-up renders
+   have to be finished and queue depth, free disk space below imagepath and
+   the render error rate of the last errorWindow seconds have to stay within
+   their thresholds. */
+
+class ReadinessMonitor
+{
+public:
+    struct Thresholds
+    {
+        qint64 maxQueueDepth {0};
+        qint64 minDiskFree   {0};
+        double maxErrorRate  {0};
+        int    errorWindow   {0};
+    };
+
+    ReadinessMonitor(const QString &directory, const Thresholds &thresholds, int warmUpRenders);
+
+    void warmUpFinished();
+    void recordRender(bool succeeded);
+
+    void setThresholds(const Thresholds &thresholds);
+
+    void beginShutdown();
+    bool isShuttingDown() const;
+
+    //fills details with the measured values, returns the reasons for not being ready
+    QStringList check(qint64 queueDepth, QJsonObject *details) const;
+
+private:
+    struct Bucket
+    {
+        qint64 second    {0};
+        qint64 succeeded {0};
+        qint64 failed    {0};
+    };
+
+    static constexpr int    BUCKET_COUNT          {300};
+    static constexpr qint64 MINIMUM_ERROR_SAMPLES {20};
+
+    double errorRate(int errorWindow, qint64 *samples) const;
+
+    const QString m_directory;
+
+    std::atomic<int>  m_pendingWarmUps;
+    std::atomic<bool> m_shuttingDown {false};
+
+    mutable QMutex                   m_mutex;
+    Thresholds                       m_thresholds;
+    std::array<Bucket, BUCKET_COUNT> m_buckets;
+};
+
+#endif // READINESSMONITOR_H
@@ -0,0 +1,53 @@
+#include "RenderCoalescer.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+
+QUuid RenderCoalescer::join(const QByteArray &key, const QUuid &uuid, const Callback &callback, bool *leader, const std::function<void()> &registerFlight)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    const auto flight {m_flights.find(key)};
+
+    if (flight == m_flights.end())
+    {
+        if (registerFlight)
+            registerFlight();
+
+        m_flights.insert(key, {uuid, {}});
+
+        if (leader)
+            *leader = true;
+
+        return uuid;
+    }
+
+    if (!callback.url.isEmpty())
+        flight->callbacks << callback;
+
+    if (leader)
+        *leader = false;
+
+    return flight->uuid;
+}
+
+QVector<RenderCoalescer::Callback> RenderCoalescer::complete(const QByteArray &key)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    return m_flights.take(key).callbacks;
+}
+
+QByteArray RenderCoalescer::keyFor(const LineChartSpec &spec)
+{
+    QByteArray serialized;
+    QDataStream stream {&serialized, QDataStream::OpenModeFlag::WriteOnly};
+    stream << spec;
+
+    return QCryptographicHash::hash(serialized, QCryptographicHash::Algorithm::Sha1);
+}
+
+QByteArray RenderCoalescer::keyFor(const QUuid &uuid)
+{
+    return uuid.toRfc4122();
+}
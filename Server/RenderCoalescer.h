@@ -0,0 +1,54 @@
+#ifndef RENDERCOALESCER_H
+#define RENDERCOALESCER_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QMutex>
+#include <QHash>
+#include <QUuid>
+#include <QUrl>
+
+#include <functional>
+
+#include "LineChartSpec.h"
+
+/* Singleflight for /line: identical specs that arrive while the first one is
+   still queued or rendering get the UUID of that render instead of their own.
+   Their callbacks are collected and handed to the render when it completes,
+   so a burst of identical POSTs costs one render. */
+
+class RenderCoalescer
+{
+public:
+    struct Callback
+    {
+        QUrl url;
+        bool inlineData {false};
+    };
+
+    /* returns the UUID that renders the spec behind key: the one in flight, with callback attached,
+       or uuid, then *leader is true and the caller has to render it and call complete();
+       a new flight is registered by registerFlight under the lock, so no one joins it before */
+    QUuid join(const QByteArray &key, const QUuid &uuid, const Callback &callback, bool *leader, const std::function<void()> &registerFlight = {});
+
+    //ends the flight once its result is visible, returns the callbacks of the requests that joined it
+    QVector<Callback> complete(const QByteArray &key);
+
+    //SHA-1 of the serialized spec
+    static QByteArray keyFor(const LineChartSpec &spec);
+
+    //the raw UUID, for renders of one particular chart such as a lazily stored one; never collides with a SHA-1
+    static QByteArray keyFor(const QUuid &uuid);
+
+private:
+    struct Flight
+    {
+        QUuid             uuid;
+        QVector<Callback> callbacks;
+    };
+
+    QMutex m_mutex;
+    QHash<QByteArray, Flight> m_flights;
+};
+
+#endif // RENDERCOALESCER_H
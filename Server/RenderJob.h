@@ -0,0 +1,33 @@
+#ifndef RENDERJOB_H
+#define RENDERJOB_H
+
+#include <QDataStream>
+#include <QUuid>
+#include <QUrl>
+
+#include "LineChartSpec.h"
+#include "SpanExporter.h"
+
+/* everything a queued /line render needs, serializable so it can be handed off on shutdown;
+   the trace context of the request is not handed off, the next instance traces the job on its own */
+
+struct RenderJob
+{
+    QUuid         uuid;
+    LineChartSpec spec;
+    QUrl          callbackUrl;
+    bool          callbackInline {false};
+    TraceContext  trace;
+};
+
+inline QDataStream &operator<<(QDataStream &stream, const RenderJob &job)
+{
+    return stream << job.uuid << job.spec << job.callbackUrl << job.callbackInline;
+}
+
+inline QDataStream &operator>>(QDataStream &stream, RenderJob &job)
+{
+    return stream >> job.uuid >> job.spec >> job.callbackUrl >> job.callbackInline;
+}
+
+#endif // RENDERJOB_H
@@ -0,0 +1,47 @@
+TARGET = Linechart-Microservice
+
+QT = core httpserver charts gui network
+
+CONFIG += c++17 cmdline
+
+include(../ChartRendering/ChartRendering.pri)
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+        AccessLog.cpp \
+        CallbackDispatcher.cpp \
+        JobRegistry.cpp \
+        LazyRenderQueue.cpp \
+        NegativeCache.cpp \
+        ReadinessMonitor.cpp \
+        RenderCoalescer.cpp \
+        ServiceConfig.cpp \
+        SpanExporter.cpp \
+        main.cpp
+
+unix: SOURCES += UnixSignalWatcher.cpp
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
+
+HEADERS += \
+    ../CommonUtilities/CommonUtilities.h \
+    AccessLog.h \
+    CallbackDispatcher.h \
+    JobRegistry.h \
+    LazyRenderQueue.h \
+    MpscRing.h \
+    NegativeCache.h \
+    ReadinessMonitor.h \
+    RenderCoalescer.h \
+    RenderJob.h \
+    ServiceConfig.h \
+    SettingsKeys.h \
+    SpanExporter.h
+
+unix: HEADERS += UnixSignalWatcher.h
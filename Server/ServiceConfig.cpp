@@ -0,0 +1,66 @@
+#include "ServiceConfig.h"
+
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+
+#include "SettingsKeys.h"
+
+ServiceConfig ServiceConfig::fromSettings(const QSettings &settings)
+{
+    ServiceConfig config;
+
+    config.renderThreads         = std::max(settings.value(RENDER_THREADS_KEY, QThread::idealThreadCount()).toInt(), 1);
+    config.renderQueueLimit      = settings.value(RENDER_QUEUELIMIT_KEY,      DEFAULT_RENDER_QUEUELIMIT).toLongLong();
+    config.statusThreads         = std::max(settings.value(STATUS_THREADS_KEY, DEFAULT_STATUS_THREADS).toInt(), 1);
+    config.statusMaxTimeout      = std::max(settings.value(STATUS_MAXTIMEOUT_KEY, DEFAULT_STATUS_MAXTIMEOUT).toInt(), 0);
+    config.callbackQueueLimit    = settings.value(CALLBACK_QUEUELIMIT_KEY,    DEFAULT_CALLBACK_QUEUELIMIT).toInt();
+    config.callbackMaxRetries    = settings.value(CALLBACK_MAXRETRIES_KEY,    DEFAULT_CALLBACK_MAXRETRIES).toInt();
+    config.callbackRetryInterval = settings.value(CALLBACK_RETRYINTERVAL_KEY, DEFAULT_CALLBACK_RETRYINTERVAL).toInt();
+    config.pngCompression        = settings.value(PNG_COMPRESSION_KEY,        DEFAULT_PNG_COMPRESSION).toInt();
+    config.jobsRetention         = settings.value(JOBS_RETENTION_KEY,         DEFAULT_JOBS_RETENTION).toLongLong();
+    config.expiryTtl             = settings.value(EXPIRY_TTL_KEY,             DEFAULT_EXPIRY_TTL).toLongLong();
+    config.shutdownDeadline      = settings.value(SHUTDOWN_DEADLINE_KEY,      DEFAULT_SHUTDOWN_DEADLINE).toLongLong();
+    config.storeBudget           = std::max(settings.value(STORE_BUDGET_KEY, DEFAULT_STORE_BUDGET).toLongLong(), qint64{0}) * 1024 * 1024;
+    config.durableWrites         = settings.value(STORE_DURABLE_KEY,          DEFAULT_STORE_DURABLE).toBool();
+    config.syncInterval          = std::max(settings.value(STORE_SYNCINTERVAL_KEY, DEFAULT_STORE_SYNCINTERVAL).toInt(), 0);
+    config.memoryTier            = std::max(settings.value(TIERS_MEMORY_KEY, DEFAULT_TIERS_MEMORY).toLongLong(), qint64{0}) * 1024 * 1024;
+    config.coldAge               = std::max(settings.value(TIERS_COLDAGE_KEY, DEFAULT_TIERS_COLDAGE).toLongLong(), qint64{0});
+    config.promoteAfter          = std::max(settings.value(TIERS_PROMOTEAFTER_KEY, DEFAULT_TIERS_PROMOTEAFTER).toInt(), 1);
+    config.negativeCacheTtl      = settings.value(NEGATIVECACHE_TTL_KEY,      DEFAULT_NEGATIVECACHE_TTL).toLongLong();
+    config.negativeCacheCapacity = settings.value(NEGATIVECACHE_CAPACITY_KEY, DEFAULT_NEGATIVECACHE_CAPACITY).toInt();
+    config.lazyRendering         = settings.value(RENDER_LAZY_KEY,            DEFAULT_RENDER_LAZY).toBool();
+    config.idleRendering         = settings.value(RENDER_IDLE_KEY,            DEFAULT_RENDER_IDLE).toBool();
+    config.timingsField          = settings.value(TIMINGS_FIELD_KEY,          DEFAULT_TIMINGS_FIELD).toBool();
+    config.bufferPoolMemory      = std::max(settings.value(RENDER_POOLMEMORY_KEY, DEFAULT_RENDER_POOLMEMORY).toLongLong(), qint64{0}) * 1024 * 1024;
+    config.bufferPoolMaxImage    = std::max(settings.value(RENDER_POOLMAXIMAGE_KEY, DEFAULT_RENDER_POOLMAXIMAGE).toLongLong(), qint64{0}) * 1024 * 1024;
+    config.accessLogSampling     = settings.value(ACCESSLOG_SAMPLING_KEY,     DEFAULT_ACCESSLOG_SAMPLING).toDouble();
+    config.accessLogSampleAbove  = settings.value(ACCESSLOG_SAMPLEABOVE_KEY,  DEFAULT_ACCESSLOG_SAMPLEABOVE).toInt();
+
+    config.readyThresholds =
+    {
+        settings.value(READY_MAXQUEUEDEPTH_KEY, DEFAULT_READY_MAXQUEUEDEPTH).toLongLong(),
+        settings.value(READY_MINDISKFREE_KEY,   DEFAULT_READY_MINDISKFREE).toLongLong() * 1024 * 1024,
+        settings.value(READY_MAXERRORRATE_KEY,  DEFAULT_READY_MAXERRORRATE).toDouble(),
+        settings.value(READY_ERRORWINDOW_KEY,   DEFAULT_READY_ERRORWINDOW).toInt()
+    };
+
+    return config;
+}
+
+LiveServiceConfig::LiveServiceConfig(const ServiceConfig &config) :
+    m_config {std::make_shared<const ServiceConfig>(config)}
+{
+
+}
+
+std::shared_ptr<const ServiceConfig> LiveServiceConfig::current() const
+{
+    return std::atomic_load(&m_config);
+}
+
+void LiveServiceConfig::publish(const ServiceConfig &config)
+{
+    std::atomic_store(&m_config, std::shared_ptr<const ServiceConfig>{std::make_shared<const ServiceConfig>(config)});
+}
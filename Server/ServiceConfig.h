@@ -0,0 +1,62 @@
+#ifndef SERVICECONFIG_H
+#define SERVICECONFIG_H
+
+#include <QSettings>
+
+#include <memory>
+
+#include "ReadinessMonitor.h"
+
+//all tunables of settings.ini which can be changed without a restart
+
+struct ServiceConfig
+{
+    int    renderThreads         {1};
+    qint64 renderQueueLimit      {0};
+    int    statusThreads         {1};
+    int    statusMaxTimeout      {0};
+    int    callbackQueueLimit    {0};
+    int    callbackMaxRetries    {0};
+    int    callbackRetryInterval {0};
+    int    pngCompression        {-1};
+    qint64 jobsRetention         {0};
+    qint64 expiryTtl             {0};
+    qint64 shutdownDeadline      {0};
+    qint64 storeBudget           {0};
+    bool   durableWrites         {false};
+    int    syncInterval          {0};
+    qint64 memoryTier            {0};
+    qint64 coldAge               {0};
+    int    promoteAfter          {0};
+    qint64 negativeCacheTtl      {0};
+    int    negativeCacheCapacity {0};
+    bool   lazyRendering         {false};
+    bool   idleRendering         {false};
+    bool   timingsField          {false};
+    qint64 bufferPoolMemory      {0};
+    qint64 bufferPoolMaxImage    {0};
+    double accessLogSampling     {1.0};
+    int    accessLogSampleAbove  {0};
+
+    ReadinessMonitor::Thresholds readyThresholds;
+
+    static ServiceConfig fromSettings(const QSettings &settings);
+};
+
+/* Holds the active ServiceConfig. A reload publishes a complete new snapshot
+   with one atomic pointer swap, every request works with the snapshot it took
+   at its start and never sees a half applied configuration. */
+
+class LiveServiceConfig
+{
+public:
+    explicit LiveServiceConfig(const ServiceConfig &config);
+
+    std::shared_ptr<const ServiceConfig> current() const;
+    void publish(const ServiceConfig &config);
+
+private:
+    std::shared_ptr<const ServiceConfig> m_config;
+};
+
+#endif // SERVICECONFIG_H
@@ -0,0 +1,93 @@
+#ifndef SETTINGSKEYS_H
+#define SETTINGSKEYS_H
+
+#include <QString>
+
+/* optional keys of settings.ini, PORT_KEY and IMAGEPATH_KEY
+   are still provided by the CommonUtilities */
+
+inline const QString CALLBACK_QUEUELIMIT_KEY    {"callback/queuelimit"};
+inline const QString CALLBACK_MAXRETRIES_KEY    {"callback/maxretries"};
+inline const QString CALLBACK_RETRYINTERVAL_KEY {"callback/retryinterval"};
+
+constexpr int DEFAULT_CALLBACK_QUEUELIMIT    {1024};
+constexpr int DEFAULT_CALLBACK_MAXRETRIES    {5};
+constexpr int DEFAULT_CALLBACK_RETRYINTERVAL {1000};
+
+inline const QString RENDER_THREADS_KEY    {"render/threads"};
+inline const QString RENDER_QUEUELIMIT_KEY {"render/queuelimit"};
+inline const QString STATUS_THREADS_KEY    {"status/threads"};
+inline const QString STATUS_MAXTIMEOUT_KEY {"status/maxtimeout"};
+inline const QString JOBS_RETENTION_KEY    {"jobs/retention"};
+inline const QString EXPIRY_TTL_KEY        {"expiry/ttl"};
+inline const QString PNG_COMPRESSION_KEY   {"png/compression"};
+inline const QString SHUTDOWN_DEADLINE_KEY {"shutdown/deadline"};
+inline const QString RENDER_LAZY_KEY       {"render/lazy"};
+inline const QString RENDER_IDLE_KEY       {"render/idle"};
+inline const QString TIMINGS_FIELD_KEY     {"timings/field"};
+
+//the buffer pool of the render targets, in MB
+inline const QString RENDER_POOLMEMORY_KEY   {"render/poolmemory"};
+inline const QString RENDER_POOLMAXIMAGE_KEY {"render/poolmaximage"};
+
+inline const QString STORE_BUDGET_KEY          {"store/budget"};
+inline const QString STORE_EVICTION_KEY        {"store/eviction"};
+inline const QString STORE_DURABLE_KEY         {"store/durable"};
+inline const QString STORE_SYNCINTERVAL_KEY    {"store/syncinterval"};
+inline const QString INDEX_EXPECTEDCHARTS_KEY  {"index/expectedcharts"};
+inline const QString TIERS_MEMORY_KEY          {"tiers/memory"};
+inline const QString TIERS_COLDAGE_KEY         {"tiers/coldage"};
+inline const QString TIERS_PROMOTEAFTER_KEY    {"tiers/promoteafter"};
+inline const QString NEGATIVECACHE_TTL_KEY      {"negativecache/ttl"};
+inline const QString NEGATIVECACHE_CAPACITY_KEY {"negativecache/capacity"};
+
+inline const QString ACCESSLOG_FILE_KEY        {"accesslog/file"};
+inline const QString ACCESSLOG_CAPACITY_KEY    {"accesslog/capacity"};
+inline const QString ACCESSLOG_SAMPLING_KEY    {"accesslog/sampling"};
+inline const QString ACCESSLOG_SAMPLEABOVE_KEY {"accesslog/sampleabove"};
+
+inline const QString TRACING_FILE_KEY     {"tracing/file"};
+inline const QString TRACING_CAPACITY_KEY {"tracing/capacity"};
+
+inline const QString READY_MAXQUEUEDEPTH_KEY {"ready/maxqueuedepth"};
+inline const QString READY_MINDISKFREE_KEY   {"ready/mindiskfree"};
+inline const QString READY_MAXERRORRATE_KEY  {"ready/maxerrorrate"};
+inline const QString READY_ERRORWINDOW_KEY   {"ready/errorwindow"};
+
+constexpr qint64 DEFAULT_RENDER_QUEUELIMIT {1024};
+constexpr int    DEFAULT_STATUS_THREADS    {64};
+constexpr int    DEFAULT_STATUS_MAXTIMEOUT {30000};
+constexpr qint64 DEFAULT_JOBS_RETENTION    {3600};
+constexpr qint64 DEFAULT_EXPIRY_TTL        {86400};
+constexpr int    DEFAULT_PNG_COMPRESSION   {-1};
+constexpr qint64 DEFAULT_SHUTDOWN_DEADLINE {20000};
+constexpr bool   DEFAULT_RENDER_LAZY       {false};
+constexpr bool   DEFAULT_RENDER_IDLE       {false};
+constexpr bool   DEFAULT_TIMINGS_FIELD     {false};
+
+constexpr qint64 DEFAULT_RENDER_POOLMEMORY   {256};
+constexpr qint64 DEFAULT_RENDER_POOLMAXIMAGE {64};
+
+constexpr qint64 DEFAULT_STORE_BUDGET          {0};
+inline const QString DEFAULT_STORE_EVICTION    {"oldest"};
+constexpr bool   DEFAULT_STORE_DURABLE         {false};
+constexpr int    DEFAULT_STORE_SYNCINTERVAL    {50};
+constexpr qint64 DEFAULT_INDEX_EXPECTEDCHARTS  {1000000};
+constexpr qint64 DEFAULT_TIERS_MEMORY          {64};
+constexpr qint64 DEFAULT_TIERS_COLDAGE         {0};
+constexpr int    DEFAULT_TIERS_PROMOTEAFTER    {3};
+constexpr qint64 DEFAULT_NEGATIVECACHE_TTL      {5000};
+constexpr int    DEFAULT_NEGATIVECACHE_CAPACITY {65536};
+
+constexpr qint64 DEFAULT_ACCESSLOG_CAPACITY    {8192};
+constexpr double DEFAULT_ACCESSLOG_SAMPLING    {1.0};
+constexpr int    DEFAULT_ACCESSLOG_SAMPLEABOVE {0};
+
+constexpr qint64 DEFAULT_TRACING_CAPACITY {16384};
+
+constexpr qint64 DEFAULT_READY_MAXQUEUEDEPTH {768};
+constexpr qint64 DEFAULT_READY_MINDISKFREE   {512};
+constexpr double DEFAULT_READY_MAXERRORRATE  {0.25};
+constexpr int    DEFAULT_READY_ERRORWINDOW   {60};
+
+#endif // SETTINGSKEYS_H
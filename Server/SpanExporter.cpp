@@ -0,0 +1,263 @@
+#include "SpanExporter.h"
+
+#include <QRandomGenerator>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QCoreApplication>
+#include <QtEndian>
+#include <QDebug>
+#include <QFile>
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+    constexpr unsigned long DrainInterval {200};
+
+    //OTLP SpanKind
+    constexpr int SpanKindInternal {1};
+    constexpr int SpanKindServer   {2};
+
+    template <std::size_t Size>
+    bool isZero(const std::array<quint8, Size> &id)
+    {
+        return std::all_of(id.begin(), id.end(), [](quint8 byte) { return byte == 0; });
+    }
+
+    template <std::size_t Size>
+    std::array<quint8, Size> randomId()
+    {
+        std::array<quint8, Size> id {};
+
+        while (isZero(id))
+            QRandomGenerator::global()->generate(id.begin(), id.end());
+
+        return id;
+    }
+
+    bool isHex(const QByteArray &hex, int digits)
+    {
+        return hex.size() == digits && std::all_of(hex.begin(), hex.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); });
+    }
+
+    //false for all-zero IDs, which are invalid
+    template <std::size_t Size>
+    bool parseHexId(const QByteArray &hex, std::array<quint8, Size> *id)
+    {
+        if (!isHex(hex, static_cast<int>(Size * 2)))
+            return false;
+
+        const QByteArray bytes {QByteArray::fromHex(hex)};
+        std::copy(bytes.begin(), bytes.end(), id->begin());
+
+        return !isZero(*id);
+    }
+
+    template <std::size_t Size>
+    QString toHex(const std::array<quint8, Size> &id)
+    {
+        return QString::fromLatin1(QByteArray{reinterpret_cast<const char *>(id.data()), static_cast<int>(Size)}.toHex());
+    }
+}
+
+bool TraceContext::isValid() const
+{
+    return !isZero(traceId) && !isZero(spanId);
+}
+
+QString TraceContext::traceIdString() const
+{
+    return toHex(traceId);
+}
+
+quint64 TraceContext::requestId() const
+{
+    return qFromBigEndian<quint64>(spanId.data());
+}
+
+TraceContext TraceContext::fromTraceparent(const QByteArray &traceparent)
+{
+    const QList<QByteArray> fields {traceparent.trimmed().split('-')};
+
+    //later versions may append fields, version ff is invalid
+    if (fields.size() < 4 || fields.at(0).size() != 2 || fields.at(0) == "ff" || (fields.at(0) == "00" && fields.size() != 4))
+        return {};
+
+    TraceContext context;
+
+    //a malformed field invalidates the whole header
+    if (!parseHexId(fields.at(1), &context.traceId) || !parseHexId(fields.at(2), &context.spanId) || !isHex(fields.at(3), 2))
+        return {};
+
+    context.sampled = (fields.at(3).toUInt(nullptr, 16) & 0x01) != 0;
+
+    return context;
+}
+
+TraceContext TraceContext::childOf(const TraceContext &parent)
+{
+    TraceContext child;
+
+    child.traceId      = parent.isValid() ? parent.traceId : randomId<16>();
+    child.spanId       = randomId<8>();
+    child.parentSpanId = parent.isValid() ? parent.spanId : std::array<quint8, 8>{};
+    child.sampled      = parent.isValid() ? parent.sampled : true;
+
+    return child;
+}
+
+SpanExporter::SpanExporter(const QString &filename, qint64 capacity) :
+    m_filename {filename},
+    m_ring {filename.isEmpty() ? 2 : capacity}
+{
+    if (!isEnabled())
+        return;
+
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->start();
+}
+
+SpanExporter::~SpanExporter()
+{
+    if (!m_thread)
+        return;
+
+    m_stopping.store(true);
+    m_thread->wait();
+}
+
+bool SpanExporter::isEnabled() const
+{
+    return !m_filename.isEmpty();
+}
+
+void SpanExporter::exportStages(const char *name, bool server, const TraceContext &trace, qint64 startTime, qint64 endTime,
+                                const StageTimings &timings, const QUuid &uuid, int status)
+{
+    if (!isEnabled() || !trace.sampled)
+        return;
+
+    append({trace.traceId, trace.spanId, trace.parentSpanId, name, server, startTime, endTime, uuid, status});
+
+    qint64 lastEnd {startTime};
+
+    for (const StageTimings::Stage stage : {StageTimings::Stage::QueueWait, StageTimings::Stage::Parse, StageTimings::Stage::Validate,
+                                            StageTimings::Stage::Build, StageTimings::Stage::Layout, StageTimings::Stage::Raster,
+                                            StageTimings::Stage::Encode, StageTimings::Stage::Store, StageTimings::Stage::Fetch})
+    {
+        if (timings.nanoseconds(stage) < 0)
+            continue;
+
+        append({trace.traceId, randomId<8>(), trace.spanId, StageTimings::stageName(stage), false, timings.startTime(stage), timings.endTime(stage), uuid, 0});
+
+        lastEnd = std::max(lastEnd, timings.endTime(stage));
+    }
+
+    if (server && lastEnd < endTime)
+        append({trace.traceId, randomId<8>(), trace.spanId, "respond", false, lastEnd, endTime, uuid, 0});
+}
+
+qint64 SpanExporter::currentTime()
+{
+    return StageTimings::currentTime();
+}
+
+void SpanExporter::append(const Span &span)
+{
+    if (!m_ring.tryPush(span))
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SpanExporter::run()
+{
+    QFile file {m_filename};
+
+    if (!file.open(QIODevice::OpenModeFlag::WriteOnly | QIODevice::OpenModeFlag::Append))
+        qWarning().noquote() << QString{"The span export file %0 could not be opened: %1"}.arg(m_filename, file.errorString());
+
+    while (true)
+    {
+        const bool stopping {m_stopping.load()};
+
+        QVector<Span> spans;
+        Span span;
+
+        while (m_ring.tryPop(&span))
+            spans << span;
+
+        if (!spans.isEmpty() && file.isOpen())
+        {
+            file.write(toOtlpJson(spans));
+            file.flush();
+        }
+
+        const qint64 dropped {m_dropped.exchange(0)};
+
+        if (dropped > 0)
+            qWarning() << "Span export fell behind, dropped" << dropped << "spans";
+
+        if (stopping)
+            return;
+
+        QThread::msleep(DrainInterval);
+    }
+}
+
+QByteArray SpanExporter::toOtlpJson(const QVector<Span> &spans)
+{
+    QJsonArray spansArray;
+
+    for (const Span &span : spans)
+    {
+        QJsonArray attributes;
+
+        if (!span.uuid.isNull())
+            attributes << QJsonObject{{"key", "linechart.uuid"}, {"value", QJsonObject{{"stringValue", span.uuid.toString(QUuid::StringFormat::WithoutBraces)}}}};
+
+        if (span.status > 0)
+            attributes << QJsonObject{{"key", "http.response.status_code"}, {"value", QJsonObject{{"intValue", QString::number(span.status)}}}};
+
+        QJsonObject spanObject
+        {
+            {"traceId",           toHex(span.traceId)},
+            {"spanId",            toHex(span.spanId)},
+            {"name",              span.name},
+            {"kind",              span.server ? SpanKindServer : SpanKindInternal},
+            {"startTimeUnixNano", QString::number(span.startTime)},
+            {"endTimeUnixNano",   QString::number(span.endTime)},
+            {"attributes",        attributes}
+        };
+
+        if (!isZero(span.parentSpanId))
+            spanObject.insert("parentSpanId", toHex(span.parentSpanId));
+
+        spansArray << spanObject;
+    }
+
+    const QJsonObject resourceObject
+    {
+        {"attributes", QJsonArray
+            {
+                QJsonObject{{"key", "service.name"},    {"value", QJsonObject{{"stringValue", QCoreApplication::applicationName()}}}},
+                QJsonObject{{"key", "service.version"}, {"value", QJsonObject{{"stringValue", QCoreApplication::applicationVersion()}}}}
+            }
+        }
+    };
+
+    const QJsonObject requestObject
+    {
+        {"resourceSpans", QJsonArray
+            {
+                QJsonObject
+                {
+                    {"resource",   resourceObject},
+                    {"scopeSpans", QJsonArray{QJsonObject{{"scope", QJsonObject{{"name", "linechart"}}}, {"spans", spansArray}}}}
+                }
+            }
+        }
+    };
+
+    return QJsonDocument{requestObject}.toJson(QJsonDocument::JsonFormat::Compact) + '\n';
+}
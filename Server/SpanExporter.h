@@ -0,0 +1,91 @@
+#ifndef SPANEXPORTER_H
+#define SPANEXPORTER_H
+
+#include <QScopedPointer>
+#include <QByteArray>
+#include <QThread>
+#include <QString>
+#include <QVector>
+#include <QUuid>
+
+#include <atomic>
+#include <array>
+
+#include "StageTimings.h"
+#include "MpscRing.h"
+
+//W3C trace context of one span: its trace, its own span ID and the span it is a child of
+struct TraceContext
+{
+    std::array<quint8, 16> traceId      {};
+    std::array<quint8, 8>  spanId       {};
+    std::array<quint8, 8>  parentSpanId {};
+    bool                   sampled      {true};
+
+    bool isValid() const;
+
+    //32 lowercase hex digits
+    QString traceIdString() const;
+
+    //the span ID as a number, identifies the request in the USDT probes
+    quint64 requestId() const;
+
+    //the caller's span from a traceparent header, e.g. 00-<trace-id>-<parent-id>-01; invalid if malformed
+    static TraceContext fromTraceparent(const QByteArray &traceparent);
+
+    //a new span below parent, the root span of a new trace if parent is invalid
+    static TraceContext childOf(const TraceContext &parent);
+};
+
+/* Exports OpenTelemetry spans as OTLP-JSON, the format of the collector's file
+   exporter: every line is one ExportTraceServiceRequest with the spans of a
+   few milliseconds. Like the AccessLog, callers only copy spans into a
+   lock-free ring, a background thread serializes and appends them. Spans of
+   traces whose caller did not sample them are not exported. */
+
+class SpanExporter
+{
+public:
+    struct Span
+    {
+        std::array<quint8, 16> traceId      {};
+        std::array<quint8, 8>  spanId       {};
+        std::array<quint8, 8>  parentSpanId {};
+        const char            *name         {""};
+        bool                   server       {false};
+        qint64                 startTime    {0};
+        qint64                 endTime      {0};
+        QUuid                  uuid;
+        int                    status       {0};
+    };
+
+    //an empty filename disables the export
+    SpanExporter(const QString &filename, qint64 capacity);
+    ~SpanExporter();
+
+    bool isEnabled() const;
+
+    /* exports the span of trace from startTime to endTime, and a child span for every stage in timings
+       from its recorded start to its end; a server span gets a respond child for the time after its last stage */
+    void exportStages(const char *name, bool server, const TraceContext &trace, qint64 startTime, qint64 endTime,
+                      const StageTimings &timings, const QUuid &uuid = {}, int status = 0);
+
+    //nanoseconds since the epoch, the clock of all span times and of StageTimings
+    static qint64 currentTime();
+
+private:
+    void append(const Span &span);
+    void run();
+
+    static QByteArray toOtlpJson(const QVector<Span> &spans);
+
+    const QString  m_filename;
+    MpscRing<Span> m_ring;
+
+    std::atomic<qint64> m_dropped  {0};
+    std::atomic<bool>   m_stopping {false};
+
+    QScopedPointer<QThread> m_thread;
+};
+
+#endif // SPANEXPORTER_H
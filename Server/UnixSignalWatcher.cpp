@@ -0,0 +1,48 @@
+#include "UnixSignalWatcher.h"
+
+#include <QSocketNotifier>
+#include <QDebug>
+
+#include <sys/socket.h>
+#include <signal.h>
+#include <unistd.h>
+
+int UnixSignalWatcher::s_socketPair[2] {-1, -1};
+
+UnixSignalWatcher::UnixSignalWatcher(const QVector<int> &signalNumbers, QObject *parent) :
+    QObject {parent}
+{
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, s_socketPair) != 0)
+    {
+        qWarning() << "Could not create the socket pair for signal handling.";
+        return;
+    }
+
+    m_socketNotifier = new QSocketNotifier {s_socketPair[1], QSocketNotifier::Type::Read, this};
+    connect(m_socketNotifier, &QSocketNotifier::activated, this, &UnixSignalWatcher::readSignal);
+
+    struct sigaction action {};
+    action.sa_handler = &UnixSignalWatcher::handleSignal;
+    action.sa_flags   = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+
+    for (const int signalNumber : signalNumbers)
+    {
+        if (::sigaction(signalNumber, &action, nullptr) != 0)
+            qWarning() << "Could not install the handler for signal" << signalNumber;
+    }
+}
+
+void UnixSignalWatcher::handleSignal(int signalNumber)
+{
+    const unsigned char number {static_cast<unsigned char>(signalNumber)};
+    [[maybe_unused]] const ssize_t written {::write(s_socketPair[0], &number, sizeof(number))};
+}
+
+void UnixSignalWatcher::readSignal()
+{
+    unsigned char number {0};
+
+    if (::read(s_socketPair[1], &number, sizeof(number)) == sizeof(number))
+        emit signalReceived(number);
+}
@@ -0,0 +1,33 @@
+#ifndef UNIXSIGNALWATCHER_H
+#define UNIXSIGNALWATCHER_H
+
+#include <QObject>
+#include <QVector>
+
+class QSocketNotifier;
+
+/* Turns unix signals into a Qt signal in the event loop. The signal handler
+   only writes the signal number into a socket pair, everything else happens
+   when the QSocketNotifier of the other end fires. */
+
+class UnixSignalWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UnixSignalWatcher(const QVector<int> &signalNumbers, QObject *parent = nullptr);
+
+signals:
+    void signalReceived(int signalNumber);
+
+private:
+    static void handleSignal(int signalNumber);
+
+    void readSignal();
+
+    static int s_socketPair[2];
+
+    QSocketNotifier *m_socketNotifier {nullptr};
+};
+
+#endif // UNIXSIGNALWATCHER_H
@@ -0,0 +1,1644 @@
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QScopedPointer>
+#include <QSettings>
+#include <QUuid>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QFontDatabase>
+#include <QTimer>
+#include <QThreadPool>
+#include <QDeadlineTimer>
+#include <QDataStream>
+#include <QTcpServer>
+#include <QFileSystemWatcher>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QFutureInterface>
+#include <QFuture>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include <QtHttpServer>
+#include <QHostAddress>
+
+#include <functional>
+#include <algorithm>
+#include <numeric>
+
+#include "CommonUtilities/CommonUtilities.h"
+#include "ChartRendering.h"
+#include "CallbackDispatcher.h"
+#include "JobRegistry.h"
+#include "ReadinessMonitor.h"
+#include "SettingsKeys.h"
+#include "RenderJob.h"
+#include "RenderCoalescer.h"
+#include "NegativeCache.h"
+#include "LazyRenderQueue.h"
+#include "ServiceConfig.h"
+#include "AccessLog.h"
+#include "SpanExporter.h"
+#include "Probes.h"
+
+#ifdef Q_OS_UNIX
+#include "UnixSignalWatcher.h"
+
+#include <csignal>
+#endif
+
+//a finished future, for answers that need neither a thread-pool hop nor I/O
+static QFuture<QHttpServerResponse> readyResponse(QHttpServerResponse &&response)
+{
+    QFutureInterface<QHttpServerResponse> futureInterface;
+    futureInterface.reportStarted();
+    futureInterface.reportAndMoveResult(std::move(response));
+    futureInterface.reportFinished();
+
+    return futureInterface.future();
+}
+
+/* reports the stages a request went through in the Server-Timing header, and also in the "Timings" field
+   of the JSON-object if timingsField is set; that re-serializes the object and is therefore opt-in */
+static QHttpServerResponse withTimings(QHttpServerResponse &&response, const StageTimings &timings, bool timingsField)
+{
+    if (timingsField)
+    {
+        QJsonObject responseObject {QJsonDocument::fromJson(response.data()).object()};
+
+        if (!responseObject.isEmpty())
+        {
+            responseObject.insert("Timings", timings.toJson());
+            response = QHttpServerResponse {responseObject, response.statusCode()};
+        }
+    }
+
+    if (!timings.isEmpty())
+        response.setHeader("Server-Timing", timings.toServerTiming());
+
+    return std::move(response);
+}
+
+//adds the timings of entry to response and hands the finished request to the access log and the span export
+static QHttpServerResponse completeResponse(QHttpServerResponse &&response, AccessLog::Entry *entry, bool timingsField, AccessLog *accessLog, SpanExporter *spanExporter)
+{
+    StageTimings timings {entry->timings};
+    timings.merge(entry->renderTimings);
+
+    QHttpServerResponse timedResponse {withTimings(std::move(response), timings, timingsField)};
+
+    entry->status        = static_cast<int>(timedResponse.statusCode());
+    entry->responseBytes = timedResponse.data().size();
+    accessLog->append(*entry);
+
+    //the render stages are exported with the span of the render job
+    spanExporter->exportStages(entry->route, true, entry->trace, entry->time, SpanExporter::currentTime(), entry->timings, entry->uuid, entry->status);
+
+    LINECHART_PROBE3(request__done, entry->trace.requestId(), entry->status, entry->responseBytes);
+
+    return timedResponse;
+}
+
+static QHttpServerResponse unknownChartResponse()
+{
+    return QHttpServerResponse
+    {
+        QJsonObject
+        {
+            {"Message", "The submitted UUID is either not linked to any chart or already expired. Please contact our support via our e-mail %0 ."}
+        }
+    };
+}
+
+static QHttpServerResponse pendingChartResponse(const QUuid &uuid, JobRegistry::State state)
+{
+    return QHttpServerResponse
+    {
+        QJsonObject
+        {
+            {"Message",    QString{"The chart of the submitted UUID is not rendered yet (status '%0'). Please poll the provided status url."}.arg(JobRegistry::stateName(state))},
+            {"StatusLink", QString{"http://127.0.0.1:50001/line/status/%0"}.arg(uuid.toString(QUuid::StringFormat::WithoutBraces))}
+        }
+    };
+}
+
+static QHttpServerResponse failedChartResponse(const QString &failure)
+{
+    return QHttpServerResponse
+    {
+        QJsonObject
+        {
+            {"Message", QString{"The chart of the submitted UUID could not be rendered. %0"}.arg(failure)}
+        }
+    };
+}
+
+//charts stored with this format are lazily rendered and only hold their packed LineChartSpec so far
+static const QByteArray lazySpecFormat {"spec"};
+
+//evicts charts in eviction order until the store fits into budget again, a budget of 0 means unlimited
+static qint64 enforceStoreBudget(qint64 budget, const ChartStore *store, ChartIndex *index, ExpiryIndex *expiry, EvictionOrder *order)
+{
+    QVector<ChartMetadata> evicted;
+
+    while (budget > 0 && index->totalSize() > budget)
+    {
+        const std::optional<QUuid> victim {order->takeFirst()};
+
+        if (!victim)
+            break;
+
+        const std::optional<ChartMetadata> metadata {index->take(*victim)};
+
+        if (!metadata)
+            continue;
+
+        expiry->remove(*victim, metadata->created);
+        evicted << *metadata;
+    }
+
+    //the files are removed in one batch, they are no longer reachable through the index
+    if (!evicted.isEmpty())
+        store->removeAsync(evicted);
+
+    return evicted.size();
+}
+
+static QHttpServerResponse chartDataResponse(const QByteArray &imageFileBytes)
+{
+    return QHttpServerResponse
+    {
+        QJsonObject
+        {
+            {"Message", "The 'Data' entry of this JSON-object contains the base64-encoded png-file data of your chart-plot."},
+            {"Data",    QString{QString{imageFileBytes.toBase64()}.toUtf8()}}
+        }
+    };
+}
+
+/* moves charts from the warm into the cold tier, which are older than coldAge and were not fetched within coldAge either;
+   in durable mode the archive is committed before the chart files are removed */
+static int migrateToColdTier(qint64 coldAge, bool durable, const ChartStore *store, ChartIndex *index, GroupCommit *committer)
+{
+    const QDateTime cutoff {QDateTime::currentDateTimeUtc().addSecs(-coldAge)};
+
+    QVector<QPair<QUuid, ChartMetadata> > candidates;
+
+    index->forEach([&candidates, &cutoff](const QUuid &uuid, const ChartMetadata &metadata)
+    {
+        if (metadata.archiveOffset < 0 && metadata.format == "png" && metadata.created < cutoff &&
+            (!metadata.lastAccessed.isValid() || metadata.lastAccessed < cutoff))
+            candidates << qMakePair(uuid, metadata);
+    });
+
+    struct Migration
+    {
+        QUuid         uuid;
+        ChartMetadata from;
+        ChartMetadata to;
+    };
+
+    QVector<Migration> migrations;
+
+    for (const QPair<QUuid, ChartMetadata> &candidate : std::as_const(candidates))
+    {
+        Migration migration {candidate.first, candidate.second, {}};
+
+        if (store->archive(migration.uuid, migration.from, &migration.to))
+            migrations << migration;
+    }
+
+    if (migrations.isEmpty() || (durable && !committer->commit().result()))
+        return 0;
+
+    QVector<ChartMetadata> migrated;
+
+    for (const Migration &migration : std::as_const(migrations))
+    {
+        //expired, evicted or re-rendered in the meantime, its record stays unreferenced in the segment
+        if (index->replace(migration.uuid, migration.from.location, migration.to))
+            migrated << migration.from;
+    }
+
+    store->removeAsync(migrated);
+
+    return migrated.size();
+}
+
+/* rewrites the archive segments of which less than three quarters are still indexed: evicted, expired and promoted
+   charts only leave the index, their records take up disk space until the whole segment is deleted */
+static int compactColdTier(bool durable, const ChartStore *store, ChartIndex *index, GroupCommit *committer)
+{
+    const QHash<QString, qint64> segments {store->sealedArchiveSegments()};
+
+    QHash<QString, QVector<QPair<QUuid, ChartMetadata> > > records;
+
+    index->forEach([&records, &segments](const QUuid &uuid, const ChartMetadata &metadata)
+    {
+        if (metadata.archiveOffset < 0)
+            return;
+
+        const QString segment {QFileInfo{metadata.location}.absoluteFilePath()};
+
+        if (segments.contains(segment))
+            records[segment] << qMakePair(uuid, metadata);
+    });
+
+    struct Migration
+    {
+        QUuid         uuid;
+        ChartMetadata from;
+        ChartMetadata to;
+    };
+
+    int compacted {0};
+
+    for (auto segment {segments.constBegin()}; segment != segments.constEnd(); ++segment)
+    {
+        const QVector<QPair<QUuid, ChartMetadata> > live {records.value(segment.key())};
+
+        //moved out by the previous compaction, fetches which looked a record up before have long finished reading it
+        if (live.isEmpty())
+        {
+            if (store->removeArchiveSegment(segment.key()))
+                ++compacted;
+
+            continue;
+        }
+
+        const qint64 liveBytes {std::accumulate(live.begin(), live.end(), qint64{0}, [](qint64 sum, const QPair<QUuid, ChartMetadata> &record) { return sum + record.second.size; })};
+
+        if (liveBytes * 4 >= segment.value() * 3)
+            continue;
+
+        QVector<Migration> migrations;
+
+        for (const QPair<QUuid, ChartMetadata> &record : live)
+        {
+            Migration migration {record.first, record.second, {}};
+
+            if (store->archive(migration.uuid, migration.from, &migration.to))
+                migrations << migration;
+        }
+
+        if (migrations.isEmpty() || (durable && !committer->commit().result()))
+            continue;
+
+        //records which could not be copied keep the segment alive until the next compaction
+        for (const Migration &migration : std::as_const(migrations))
+            index->replace(migration.uuid, migration.from.location, migration.to);
+    }
+
+    return compacted;
+}
+
+static std::optional<ChartMetadata> findChart(const ChartStore *store, ChartIndex *index, const QUuid &uuid)
+{
+    const std::optional<ChartMetadata> metadata {index->find(uuid)};
+
+    //while the index is still being rebuilt, older charts are only known to the store
+    if (metadata || index->isReady())
+        return metadata;
+
+    ChartMetadata fileMetadata;
+
+    if (!store->describe(store->locationFor(uuid, "png"), nullptr, &fileMetadata) &&
+        !store->describe(store->locationFor(uuid, lazySpecFormat), nullptr, &fileMetadata))
+        return std::nullopt;
+
+    index->insert(uuid, fileMetadata);
+    return fileMetadata;
+}
+
+int main(int argc, char *argv[])
+{
+    selectOffscreenPlatform();
+
+    QApplication app {argc, argv};
+
+    QCoreApplication::setApplicationName("LineChart-Microservice");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser commandlineParser;
+    commandlineParser.addHelpOption();
+    commandlineParser.addVersionOption();
+    commandlineParser.setApplicationDescription("Microservice for LineChart-Plotting.");
+
+    const QCommandLineOption batchOption {"batch", "Renders every /line record of a JSONL <file> without starting the HTTP server.", "file"};
+    const QCommandLineOption outOption   {"out",   "Output <directory> for the charts of --batch.", "directory"};
+
+    commandlineParser.addOption(batchOption);
+    commandlineParser.addOption(outOption);
+    commandlineParser.process(app);
+
+    if (commandlineParser.isSet(batchOption))
+    {
+        if (!commandlineParser.isSet(outOption))
+            commandlineParser.showHelp(-107);
+
+        const BatchRenderer batchRenderer {commandlineParser.value(outOption), QThread::idealThreadCount(), DEFAULT_PNG_COMPRESSION};
+        BatchRenderer::Report report;
+
+        if (!batchRenderer.run(commandlineParser.value(batchOption), &report))
+            commandlineParser.showHelp(-108);
+
+        qInfo().noquote() << BatchRenderer::formatReport(report);
+        return report.failed == 0 ? 0 : 1;
+    }
+
+    const QString settingsFilename {QApplication::applicationDirPath() + QDir::separator() + "settings.ini"};
+
+    if (!QFile::exists(settingsFilename))
+        commandlineParser.showHelp(-100);
+
+    const QSettings settings {settingsFilename, QSettings::Format::IniFormat, &app};
+
+    if (!settings.allKeys().contains(PORT_KEY))
+        commandlineParser.showHelp(-101);
+
+    const quint64 port {settings.value(PORT_KEY).toULongLong()};
+
+    if (port > HIGHEST_PORT || port < LOWEST_PORT)
+        commandlineParser.showHelp(-102);
+
+    if (!settings.allKeys().contains(IMAGEPATH_KEY))
+        commandlineParser.showHelp(-103);
+
+    static const QString imagepath {settings.value(IMAGEPATH_KEY).toString()};
+
+    if (imagepath.isEmpty())
+        commandlineParser.showHelp(-104);
+
+    if (!QFile::exists(imagepath))
+        commandlineParser.showHelp(-105);
+
+    if (QDir::isRelativePath(imagepath))
+        commandlineParser.showHelp(-106);
+
+    const std::optional<EvictionOrder::Policy> evictionPolicy {EvictionOrder::policyFromName(settings.value(STORE_EVICTION_KEY, DEFAULT_STORE_EVICTION).toString())};
+
+    if (!evictionPolicy)
+        commandlineParser.showHelp(-109);
+
+    //everything except port and imagepath can be reloaded at runtime, see reloadSettings below
+    const QScopedPointer<LiveServiceConfig> liveConfig {new LiveServiceConfig {ServiceConfig::fromSettings(settings)}};
+    const std::shared_ptr<const ServiceConfig> initialConfig {liveConfig->current()};
+
+    const QScopedPointer<CallbackDispatcher> callbackDispatcher
+    {
+        new CallbackDispatcher
+        {
+            initialConfig->callbackQueueLimit,
+            initialConfig->callbackMaxRetries,
+            initialConfig->callbackRetryInterval
+        }
+    };
+
+    //request threads only copy their entry into the ring of the access log, its own thread writes the file
+    const QString accessLogFilename {settings.value(ACCESSLOG_FILE_KEY).toString()};
+
+    const QScopedPointer<AccessLog> accessLog
+    {
+        new AccessLog
+        {
+            accessLogFilename.isEmpty() ? QString{} : QDir{QApplication::applicationDirPath()}.absoluteFilePath(accessLogFilename),
+            settings.value(ACCESSLOG_CAPACITY_KEY, DEFAULT_ACCESSLOG_CAPACITY).toLongLong(),
+            initialConfig->accessLogSampling,
+            initialConfig->accessLogSampleAbove
+        }
+    };
+
+    const QString spanExportFilename {settings.value(TRACING_FILE_KEY).toString()};
+
+    const QScopedPointer<SpanExporter> spanExporter
+    {
+        new SpanExporter
+        {
+            spanExportFilename.isEmpty() ? QString{} : QDir{QApplication::applicationDirPath()}.absoluteFilePath(spanExportFilename),
+            settings.value(TRACING_CAPACITY_KEY, DEFAULT_TRACING_CAPACITY).toLongLong()
+        }
+    };
+
+    //temporary files older than this are left by the previous instance, with some slack for coarse file timestamps
+    const QDateTime interruptedWritesBefore {QDateTime::currentDateTimeUtc().addSecs(-2)};
+
+    const QScopedPointer<JobRegistry> jobRegistry {new JobRegistry};
+    const QScopedPointer<ChartStore>  chartStore  {new ChartStore {imagepath}};
+    const QScopedPointer<ChartIndex>  chartIndex  {new ChartIndex {settings.value(INDEX_EXPECTEDCHARTS_KEY, DEFAULT_INDEX_EXPECTEDCHARTS).toLongLong()}};
+    const QScopedPointer<ExpiryIndex> expiryIndex {new ExpiryIndex};
+    const QScopedPointer<GroupCommit> groupCommit {new GroupCommit {chartStore.data(), initialConfig->syncInterval}};
+
+    const QScopedPointer<EvictionOrder> evictionOrder {new EvictionOrder {*evictionPolicy}};
+
+    const QScopedPointer<RenderCoalescer> renderCoalescer {new RenderCoalescer};
+    const QScopedPointer<NegativeCache>   negativeCache   {new NegativeCache {initialConfig->negativeCacheTtl, initialConfig->negativeCacheCapacity}};
+    const QScopedPointer<LazyRenderQueue> lazyRenderQueue {new LazyRenderQueue};
+    const QScopedPointer<ChartCache>      chartCache      {new ChartCache {initialConfig->memoryTier}};
+
+    static const QString indexSnapshotFilename {imagepath + QDir::separator() + ".chartindex"};
+    static const QString handoffFilename       {imagepath + QDir::separator() + ".handoff"};
+
+    const int renderThreads {initialConfig->renderThreads};
+
+    const QScopedPointer<ReadinessMonitor> readinessMonitor
+    {
+        new ReadinessMonitor
+        {
+            imagepath,
+            initialConfig->readyThresholds,
+            renderThreads
+        }
+    };
+
+    //deflates the bands a render job rasterized, while the job already rasterizes the next band
+    const QScopedPointer<QThreadPool> encodePool {new QThreadPool};
+    encodePool->setMaxThreadCount(renderThreads);
+
+    ImageBufferPool::globalInstance()->setLimits(initialConfig->bufferPoolMemory, initialConfig->bufferPoolMaxImage);
+
+    /* the renderPool has to be declared after jobRegistry, callbackDispatcher, readinessMonitor, groupCommit and encodePool,
+       so it is destroyed first and waits for running render jobs on exit */
+
+    const QScopedPointer<QThreadPool> renderPool {new QThreadPool};
+    renderPool->setMaxThreadCount(renderThreads);
+
+    //long-polls on /line/status block their thread, so they must not starve the global pool
+    const QScopedPointer<QThreadPool> statusPool {new QThreadPool};
+    statusPool->setMaxThreadCount(initialConfig->statusThreads);
+
+    QTimer jobPruneTimer;
+    QObject::connect(&jobPruneTimer, &QTimer::timeout, &app,
+    [registry = jobRegistry.data(), config = liveConfig.data()]()
+    {
+        registry->prune(config->current()->jobsRetention);
+    });
+    jobPruneTimer.start(60000);
+
+    QTimer expiryTimer;
+    QObject::connect(&expiryTimer, &QTimer::timeout, &app,
+    [store = chartStore.data(), index = chartIndex.data(), expiry = expiryIndex.data(), order = evictionOrder.data(), committer = groupCommit.data(), config = liveConfig.data()]()
+    {
+        const std::shared_ptr<const ServiceConfig> sweepConfig {config->current()};
+
+        QtConcurrent::run([store, index, expiry, order, committer, ttl = sweepConfig->expiryTtl, budget = sweepConfig->storeBudget,
+                           coldAge = sweepConfig->coldAge, durable = sweepConfig->durableWrites]()
+        {
+            QVector<ChartMetadata> expired;
+
+            for (const QUuid &uuid : expiry->takeExpired(QDateTime::currentDateTimeUtc().addSecs(-ttl)))
+            {
+                order->remove(uuid);
+
+                const std::optional<ChartMetadata> metadata {index->take(uuid)};
+
+                if (metadata)
+                    expired << *metadata;
+            }
+
+            if (!expired.isEmpty())
+                store->removeAsync(expired);
+
+            store->removeArchiveSegmentsBefore(QDateTime::currentDateTimeUtc().addSecs(-ttl));
+
+            //catches up after the budget was lowered by a reload
+            if (index->isReady())
+                enforceStoreBudget(budget, store, index, expiry, order);
+
+            //gives the disk space of archived charts which were evicted for the budget back
+            if (index->isReady())
+                compactColdTier(durable, store, index, committer);
+
+            if (coldAge > 0 && index->isReady())
+                migrateToColdTier(coldAge, durable, store, index, committer);
+
+            //the expired and evicted UUIDs would otherwise fill up the filter of the fast miss path
+            if (index->isReady())
+                index->rebuildFilter();
+        });
+    });
+    expiryTimer.start(60000);
+
+    /* used by POST /line, for lazily stored charts and for the jobs a previous instance handed off on shutdown;
+       returns the UUID the chart is rendered under, which is the one of the render in flight for the same key if there is one */
+    const std::function<QUuid(const RenderJob &, const QByteArray &)> submitRenderJob =
+    [dispatcher = callbackDispatcher.data(), registry = jobRegistry.data(), store = chartStore.data(), index = chartIndex.data(), expiry = expiryIndex.data(), order = evictionOrder.data(), monitor = readinessMonitor.data(), config = liveConfig.data(), coalescer = renderCoalescer.data(), negatives = negativeCache.data(), committer = groupCommit.data(), cache = chartCache.data(), tracer = spanExporter.data(), encoders = encodePool.data(), pool = renderPool.data()](const RenderJob &job, const QByteArray &key)
+    {
+        QByteArray payload;
+        QDataStream payloadStream {&payload, QDataStream::OpenModeFlag::WriteOnly};
+        payloadStream << job;
+
+        //the job is in the registry before anyone can join its flight and wait for it there
+        bool leader {false};
+        const QUuid uuid {coalescer->join(key, job.uuid, {job.callbackUrl, job.callbackInline}, &leader, [registry, &job, &payload]() { registry->enqueue(job.uuid, payload); })};
+
+        if (!leader)
+            return uuid;
+
+        pool->start([dispatcher, registry, store, index, expiry, order, monitor, config, coalescer, negatives, committer, cache, tracer, encoders, job, key]()
+        {
+            //handed off to the next instance during shutdown
+            if (!registry->start(job.uuid))
+                return;
+
+            //a lazily stored chart which the previous flight for its UUID published after this job read the spec
+            const std::optional<ChartMetadata> published {index->find(job.uuid)};
+
+            if (published && published->format != lazySpecFormat)
+            {
+                registry->finish(job.uuid, true, {}, {});
+                coalescer->complete(key);
+                return;
+            }
+
+            const qint64 startTime {SpanExporter::currentTime()};
+
+            LINECHART_PROBE2(render__start, job.trace.requestId(), lineChartPointCount(job.spec));
+
+            const QString uuidString {job.uuid.toString(QUuid::StringFormat::WithoutBraces)};
+
+            const std::shared_ptr<const ServiceConfig> jobConfig {config->current()};
+
+            QByteArray imageBytes;
+            QString failure;
+            StageTimings renderTimings;
+
+            if (!renderLineChartPngStreamed(job.spec, jobConfig->pngCompression, encoders, &imageBytes, &renderTimings))
+                failure = "The chart could not be rendered.";
+            else if (jobConfig->storeBudget > 0 && imageBytes.size() > jobConfig->storeBudget)
+                failure = "The chart is larger than the storage budget of the service.";
+
+            LINECHART_PROBE3(render__done, job.trace.requestId(), imageBytes.size(), failure.isEmpty());
+
+            //makes the chart visible and notifies its clients, in durable mode only once the group commit covered the chart
+            const auto publish = [=](const QString &failure, const ChartMetadata &metadata, const StageTimings &timings)
+            {
+                const bool saved {failure.isEmpty()};
+
+                ChartMetadata published {metadata};
+
+                if (saved)
+                {
+                    //a lazily stored chart keeps the creation time of its POST, it is already in the expiry index and the eviction order
+                    const std::optional<ChartMetadata> storedSpec {index->find(job.uuid)};
+                    const bool wasLazy {storedSpec && storedSpec->format == lazySpecFormat};
+
+                    if (wasLazy)
+                        published.created = storedSpec->created;
+
+                    negatives->remove(job.uuid);
+                    index->insert(job.uuid, published);
+
+                    //the newest charts start in the memory tier
+                    cache->insert(job.uuid, imageBytes);
+
+                    if (wasLazy)
+                    {
+                        store->removeAsync({*storedSpec});
+                    }
+                    else
+                    {
+                        expiry->insert(job.uuid, published.created);
+                        order->insert(job.uuid, published.created);
+                    }
+
+                    //the new chart is the last in eviction order and fits into the budget, so it is never evicted here
+                    if (index->isReady())
+                        enforceStoreBudget(jobConfig->storeBudget, store, index, expiry, order);
+                }
+                else
+                {
+                    qWarning().noquote() << QString{"Render job %0 failed: %1"}.arg(job.uuid.toString(QUuid::StringFormat::WithoutBraces), failure);
+                }
+
+                registry->finish(job.uuid, saved, failure, timings);
+                monitor->recordRender(saved);
+
+                LINECHART_PROBE3(render__published, job.trace.requestId(), metadata.size, saved);
+
+                //a child of the span of the request which queued the job
+                tracer->exportStages("render", false, TraceContext::childOf(job.trace), startTime, SpanExporter::currentTime(), timings, job.uuid);
+
+                //the identical requests which joined this render are notified along with its own
+                QVector<RenderCoalescer::Callback> callbacks {coalescer->complete(key)};
+
+                if (!job.callbackUrl.isEmpty())
+                    callbacks.prepend({job.callbackUrl, job.callbackInline});
+
+                if (callbacks.isEmpty())
+                    return;
+
+                QJsonObject callbackObject
+                {
+                    {"Uuid",   uuidString},
+                    {"Status", JobRegistry::stateName(saved ? JobRegistry::State::Done : JobRegistry::State::Failed)}
+                };
+
+                if (saved)
+                {
+                    callbackObject.insert("Link",    QString{"http://127.0.0.1:50001/line/result/%0"}.arg(uuidString));
+                    callbackObject.insert("Message", "The provided url will expire in 24 hours.");
+                }
+                else
+                {
+                    callbackObject.insert("Message", QString{"%0 Please try again later."}.arg(failure));
+                }
+
+                const QString imageData {saved ? QString{imageBytes.toBase64()} : QString{}};
+
+                for (const RenderCoalescer::Callback &callback : std::as_const(callbacks))
+                {
+                    QJsonObject callbackData {callbackObject};
+
+                    if (saved && callback.inlineData)
+                        callbackData.insert("Data", imageData);
+
+                    if (!dispatcher->enqueue(callback.url, callbackData))
+                        qWarning() << "Callback queue is full, dropped notification for" << uuidString;
+                }
+            };
+
+            if (!failure.isEmpty())
+            {
+                publish(failure, {}, renderTimings);
+                return;
+            }
+
+            QElapsedTimer storeTimer;
+            storeTimer.start();
+
+            //the render thread moves on to the next job while the chart is written
+            store->writeAsync(job.uuid, "png", imageBytes).then(QtFuture::Launch::Async,
+            [publish, store, committer, renderTimings, storeTimer, durableWrites = jobConfig->durableWrites](const ChartMetadata &metadata)
+            {
+                StageTimings timings {renderTimings};
+                timings.add(StageTimings::Stage::Store, storeTimer.nsecsElapsed());
+
+                if (metadata.location.isEmpty())
+                {
+                    publish("The chart could not be written.", metadata, timings);
+                    return;
+                }
+
+                if (!durableWrites)
+                {
+                    publish({}, metadata, timings);
+                    return;
+                }
+
+                QElapsedTimer commitTimer;
+                commitTimer.start();
+
+                //the wait for the group commit is part of the store stage
+                committer->commit().then(QtFuture::Launch::Async, [publish, store, metadata, timings, commitTimer](bool durable) mutable
+                {
+                    if (!durable)
+                        store->remove(metadata);
+
+                    timings.add(StageTimings::Stage::Store, commitTimer.nsecsElapsed());
+                    publish(durable ? QString{} : QString{"The chart could not be written durably."}, metadata, timings);
+                });
+            });
+        });
+
+        return uuid;
+    };
+
+    /* queues the render of a lazily stored chart, keyed by its UUID so concurrent fetches share one render;
+       returns metadata if the render is queued, the chart's metadata if a render published it meanwhile */
+    const std::function<std::optional<ChartMetadata>(const QUuid &, const ChartMetadata &, const TraceContext &)> renderStoredSpec =
+    [store = chartStore.data(), index = chartIndex.data(), submitRenderJob](const QUuid &uuid, const ChartMetadata &metadata, const TraceContext &trace) -> std::optional<ChartMetadata>
+    {
+        QByteArray specBytes;
+        LineChartSpec spec;
+
+        if (!store->read(metadata, &specBytes) || !unpackLineChartSpec(specBytes, &spec))
+        {
+            //the publish of a render removes the spec
+            const std::optional<ChartMetadata> rendered {index->find(uuid)};
+
+            if (rendered && rendered->format != lazySpecFormat)
+                return rendered;
+
+            qWarning().noquote() << QString{"The stored spec of chart %0 could not be read"}.arg(uuid.toString(QUuid::StringFormat::WithoutBraces));
+            return std::nullopt;
+        }
+
+        submitRenderJob({uuid, spec, {}, false, trace}, RenderCoalescer::keyFor(uuid));
+        return metadata;
+    };
+
+    const QScopedPointer<QHttpServer> httpServer {new QHttpServer {&app}};
+
+    httpServer->route("/line", QHttpServerRequest::Method::Post,
+    [registry = jobRegistry.data(), store = chartStore.data(), index = chartIndex.data(), expiry = expiryIndex.data(), order = evictionOrder.data(), monitor = readinessMonitor.data(), config = liveConfig.data(), lazyQueue = lazyRenderQueue.data(), committer = groupCommit.data(), log = accessLog.data(), tracer = spanExporter.data(), submitRenderJob](const QHttpServerRequest &request) -> QFuture<QHttpServerResponse>
+    {
+        QElapsedTimer queueTimer;
+        queueTimer.start();
+
+        //filled on the pool thread, the continuation that completes the response runs after it
+        const std::shared_ptr<AccessLog::Entry> entry {std::make_shared<AccessLog::Entry>()};
+        entry->time         = SpanExporter::currentTime();
+        entry->route        = "/line";
+        entry->requestBytes = request.body().size();
+        entry->trace        = TraceContext::childOf(TraceContext::fromTraceparent(request.value("traceparent")));
+
+        LINECHART_PROBE3(request__start, entry->trace.requestId(), entry->route, entry->requestBytes);
+
+        return QtConcurrent::run([registry, store, index, expiry, order, monitor, config, lazyQueue, committer, submitRenderJob, entry, queueTimer, body = request.body()]()
+        {
+            entry->timings.add(StageTimings::Stage::QueueWait, queueTimer.nsecsElapsed());
+
+            LINECHART_PROBE1(request__dequeue, entry->trace.requestId());
+
+            StageClock clock {&entry->timings};
+
+            const QJsonDocument jsonDocument {QJsonDocument::fromJson(body)};
+
+            if (jsonDocument.isNull())
+            {
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", "Invalid data sent. Please send a valid JSON-Object."}
+                    }
+                };
+            }
+
+            const QJsonObject jsonObject {jsonDocument.object()};
+
+            if (jsonObject.isEmpty())
+            {
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", "Invalid data sent. Please send a valid JSON-Object."}
+                    }
+                };
+            }
+
+            clock.lap(StageTimings::Stage::Parse);
+
+            LINECHART_PROBE2(parse__done, entry->trace.requestId(), entry->requestBytes);
+
+            LineChartSpec spec;
+            QString errorMessage;
+
+            if (!parseLineChartSpec(jsonObject, &spec, &errorMessage))
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", errorMessage}
+                    }
+                };
+
+            entry->seriesCount = spec.captionToPoints.size();
+            entry->pointCount  = lineChartPointCount(spec);
+
+            if (jsonObject.contains("CallbackUrl") && !CallbackDispatcher::isValidCallbackUrl(QUrl{jsonObject.value("CallbackUrl").toString(), QUrl::ParsingMode::StrictMode}))
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", "Invalid data sent. JSON-Key 'CallbackUrl' is not a valid http or https url. Please send a valid JSON-Object."}
+                    }
+                };
+
+            if (jsonObject.contains("CallbackInline") && !jsonObject.value("CallbackInline").isBool())
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", "Invalid data sent. JSON-Key 'CallbackInline' is not a boolean value. Please send a valid JSON-Object."}
+                    }
+                };
+
+            clock.lap(StageTimings::Stage::Validate);
+
+            LINECHART_PROBE3(validate__done, entry->trace.requestId(), entry->pointCount, entry->seriesCount);
+
+            if (monitor->isShuttingDown())
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", "The service is shutting down. Please try again later."}
+                    },
+                    QHttpServerResponder::StatusCode::ServiceUnavailable
+                };
+
+            const QUrl callbackUrl    {jsonObject.value("CallbackUrl").toString(), QUrl::ParsingMode::StrictMode};
+            const bool callbackInline {jsonObject.value("CallbackInline").toBool()};
+
+            const std::shared_ptr<const ServiceConfig> requestConfig {config->current()};
+
+            //lazy rendering only stores the spec, the chart is rendered on its first fetch; a callback needs the chart right away
+            if (requestConfig->lazyRendering && callbackUrl.isEmpty())
+            {
+                const QUuid   uuid       {QUuid::createUuid()};
+                const QString uuidString {uuid.toString(QUuid::StringFormat::WithoutBraces)};
+
+                ChartMetadata metadata;
+
+                const bool stored {store->write(uuid, lazySpecFormat, packLineChartSpec(spec), &metadata) &&
+                                   (!requestConfig->durableWrites || committer->commit().result())};
+
+                clock.lap(StageTimings::Stage::Store);
+
+                LINECHART_PROBE3(store__done, entry->trace.requestId(), metadata.size, stored);
+
+                if (!stored)
+                {
+                    store->remove(metadata);
+
+                    return QHttpServerResponse
+                    {
+                        QJsonObject
+                        {
+                            {"Message", "An internal error (errorcode 102) has occured. Please contact our support via our e-mail %0 ."}
+                        }
+                    };
+                }
+
+                index->insert(uuid, metadata);
+                expiry->insert(uuid, metadata.created);
+                order->insert(uuid, metadata.created);
+                if (requestConfig->idleRendering)
+                    lazyQueue->enqueue(uuid);
+
+                entry->uuid = uuid;
+
+                if (index->isReady())
+                    enforceStoreBudget(requestConfig->storeBudget, store, index, expiry, order);
+
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Uuid",    uuidString},
+                        {"Link",    QString{"http://127.0.0.1:50001/line/result/%0"}.arg(uuidString)},
+                        {"Message", "The chart will be rendered when it is fetched for the first time. The provided url will expire in 24 hours."}
+                    }
+                };
+            }
+
+            if (registry->queuedCount() >= requestConfig->renderQueueLimit)
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", "The render queue is full. Please try again later."}
+                    },
+                    QHttpServerResponder::StatusCode::ServiceUnavailable
+                };
+
+            const QUuid   jobUuid    {QUuid::createUuid()};
+            const QUuid   uuid       {submitRenderJob({jobUuid, spec, callbackUrl, callbackInline, entry->trace}, RenderCoalescer::keyFor(spec))};
+            const QString uuidString {uuid.toString(QUuid::StringFormat::WithoutBraces)};
+            const QString link       {QString{"http://127.0.0.1:50001/line/result/%0"}.arg(uuidString)};
+            const QString statusLink {QString{"http://127.0.0.1:50001/line/status/%0"}.arg(uuidString)};
+
+            QJsonObject responseObject
+            {
+                {"Uuid",       uuidString},
+                {"Link",       link},
+                {"StatusLink", statusLink},
+                {"Message",    "The chart has been queued for rendering. The provided url will expire in 24 hours."}
+            };
+
+            if (!callbackUrl.isEmpty())
+                responseObject.insert("Callback", QString{"The result will additionally be sent to '%0'."}.arg(callbackUrl.toString()));
+
+            //joined the identical render in flight
+            entry->uuid     = uuid;
+            entry->cacheHit = uuid != jobUuid;
+
+            LINECHART_PROBE2(render__queued, entry->trace.requestId(), entry->cacheHit);
+
+            return QHttpServerResponse
+            {
+                responseObject
+            };
+
+        }).then([entry, config, log, tracer](QHttpServerResponse response)
+        {
+            return completeResponse(std::move(response), entry.get(), config->current()->timingsField, log, tracer);
+        });
+    });
+
+    httpServer->route("/line", QHttpServerRequest::Method::Get     |
+                               QHttpServerRequest::Method::Put     |
+                               QHttpServerRequest::Method::Head    |
+                               QHttpServerRequest::Method::Trace   |
+                               QHttpServerRequest::Method::Patch   |
+                               QHttpServerRequest::Method::Delete  |
+                               QHttpServerRequest::Method::Options |
+                               QHttpServerRequest::Method::Connect |
+                               QHttpServerRequest::Method::Unknown,
+    [config = liveConfig.data(), log = accessLog.data(), tracer = spanExporter.data()](const QHttpServerRequest &request) -> QFuture<QHttpServerResponse>
+    {
+        QElapsedTimer queueTimer;
+        queueTimer.start();
+
+        AccessLog::Entry entry;
+        entry.time         = SpanExporter::currentTime();
+        entry.route        = "/line";
+        entry.requestBytes = request.body().size();
+        entry.trace        = TraceContext::childOf(TraceContext::fromTraceparent(request.value("traceparent")));
+
+        LINECHART_PROBE3(request__start, entry.trace.requestId(), entry.route, entry.requestBytes);
+
+        return QtConcurrent::run([config, log, tracer, queueTimer, entry]() mutable
+        {
+            entry.timings.add(StageTimings::Stage::QueueWait, queueTimer.nsecsElapsed());
+
+            return completeResponse(QHttpServerResponse
+            {
+                QJsonObject
+                {
+                    {"Message", "The used HTTP-Method is not implemented."}
+                }
+            }, &entry, config->current()->timingsField, log, tracer);
+        });
+    });
+
+    httpServer->route("/line/result/<arg>", QHttpServerRequest::Method::Get     |
+                                            QHttpServerRequest::Method::Put     |
+                                            QHttpServerRequest::Method::Head    |
+                                            QHttpServerRequest::Method::Trace   |
+                                            QHttpServerRequest::Method::Patch   |
+                                            QHttpServerRequest::Method::Delete  |
+                                            QHttpServerRequest::Method::Options |
+                                            QHttpServerRequest::Method::Connect |
+                                            QHttpServerRequest::Method::Unknown,
+    [registry = jobRegistry.data(), store = chartStore.data(), index = chartIndex.data(), order = evictionOrder.data(), negatives = negativeCache.data(), cache = chartCache.data(), config = liveConfig.data(), log = accessLog.data(), tracer = spanExporter.data(), statusPool = statusPool.data(), renderStoredSpec](const QString &argument, const QHttpServerRequest &request) -> QFuture<QHttpServerResponse>
+    {
+        QElapsedTimer queueTimer;
+        queueTimer.start();
+
+        AccessLog::Entry entry;
+        entry.time  = SpanExporter::currentTime();
+        entry.route = "/line/result";
+        entry.trace = TraceContext::childOf(TraceContext::fromTraceparent(request.value("traceparent")));
+
+        LINECHART_PROBE3(request__start, entry.trace.requestId(), entry.route, entry.requestBytes);
+
+        /* definite misses are answered right here on the event loop, without a thread-pool hop or filesystem access:
+           unknown to the registry, and either never inserted into the (complete) index or recently not found */
+
+        const QUuid requestedUuid {QUuid::fromString(argument)};
+
+        if (!requestedUuid.isNull() && index->isReady() && !registry->status(requestedUuid) &&
+            (!index->mightContain(requestedUuid) || negatives->contains(requestedUuid)))
+        {
+            entry.uuid = requestedUuid;
+            entry.timings.add(StageTimings::Stage::Fetch, queueTimer.nsecsElapsed());
+
+            return readyResponse(completeResponse(unknownChartResponse(), &entry, config->current()->timingsField, log, tracer));
+        }
+
+        //serves a chart which is stored as PNG from the memory tier or the store, the fetch time up to the call is booked by the caller
+        static std::function<QFuture<QHttpServerResponse>(const QUuid &, const ChartMetadata &, AccessLog::Entry)> chartFunction = [store, index, order, cache, config, log, tracer](const QUuid &uuid, const ChartMetadata &metadata, AccessLog::Entry entry) -> QFuture<QHttpServerResponse>
+        {
+            StageClock clock {&entry.timings};
+
+            const bool timingsField {config->current()->timingsField};
+
+            index->recordAccess(uuid);
+            order->touch(uuid);
+
+            const QByteArray cachedBytes {cache->find(uuid)};
+
+            if (!cachedBytes.isNull())
+            {
+                clock.lap(StageTimings::Stage::Fetch);
+                entry.cacheHit = true;
+
+                LINECHART_PROBE3(fetch__done, entry.trace.requestId(), cachedBytes.size(), entry.cacheHit);
+
+                return readyResponse(completeResponse(chartDataResponse(cachedBytes), &entry, timingsField, log, tracer));
+            }
+
+            clock.lap(StageTimings::Stage::Fetch);
+
+            QElapsedTimer fetchTimer;
+            fetchTimer.start();
+
+            //the pool thread is released while the file is read
+            return store->readAsync(metadata).then(QtFuture::Launch::Async,
+            [store, index, cache, log, tracer, uuid, entry, fetchTimer, timingsField, archived = metadata, promoteAfter = config->current()->promoteAfter](const QByteArray &imageFileBytes) mutable
+            {
+                entry.timings.add(StageTimings::Stage::Fetch, fetchTimer.nsecsElapsed());
+
+                LINECHART_PROBE3(fetch__done, entry.trace.requestId(), imageFileBytes.size(), entry.cacheHit);
+
+                if (imageFileBytes.isNull())
+                    return completeResponse(QHttpServerResponse
+                    {
+                        QJsonObject
+                        {
+                            {"Message", "An internal error (errorcode 100) has occured. Please contact our support via our e-mail %0 ."}
+                        }
+                    }, &entry, timingsField, log, tracer);
+
+                if (imageFileBytes.isEmpty())
+                    return completeResponse(QHttpServerResponse
+                    {
+                        QJsonObject
+                        {
+                            {"Message", "An internal error (errorcode 101) has occured. Please contact our support via our e-mail %0 ."}
+                        }
+                    }, &entry, timingsField, log, tracer);
+
+                cache->insert(uuid, imageFileBytes);
+
+                //an archived chart that is fetched again and again moves back into the warm tier
+                if (archived.archiveOffset >= 0 && archived.accessCount + 1 >= promoteAfter)
+                {
+                    //like the other write continuations not on the thread which completed the write, e.g. the io_uring completion thread
+                    store->writeAsync(uuid, archived.format, imageFileBytes).then(QtFuture::Launch::Async, [store, index, uuid, archived](const ChartMetadata &written)
+                    {
+                        if (written.location.isEmpty() || index->replace(uuid, archived.location, written))
+                            return;
+
+                        //a concurrent fetch promoted the chart to the same file first, which is indexed now
+                        const std::optional<ChartMetadata> current {index->find(uuid)};
+
+                        if (!current || current->location != written.location)
+                            store->remove(written);
+                    });
+                }
+
+                return completeResponse(chartDataResponse(imageFileBytes), &entry, timingsField, log, tracer);
+            });
+        };
+
+        static std::function<QFuture<QHttpServerResponse>(const QString &, const QElapsedTimer &, AccessLog::Entry)> responseFunction = [registry, store, index, negatives, config, log, tracer, statusPool, renderStoredSpec](const QString &argument, const QElapsedTimer &queueTimer, AccessLog::Entry entry) -> QFuture<QHttpServerResponse>
+        {
+            entry.timings.add(StageTimings::Stage::QueueWait, queueTimer.nsecsElapsed());
+
+            LINECHART_PROBE1(request__dequeue, entry.trace.requestId());
+
+            StageClock clock {&entry.timings};
+
+            const bool timingsField {config->current()->timingsField};
+
+            const auto respond = [&entry, timingsField, log, tracer](QHttpServerResponse &&response)
+            {
+                return readyResponse(completeResponse(std::move(response), &entry, timingsField, log, tracer));
+            };
+
+            //see, if it is a correct uuid
+            const QUuid uuid {QUuid::fromString(argument)};
+
+            entry.uuid = uuid;
+
+            if (uuid.isNull())
+                return respond(QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", "The submitted argument is not an UUID. Please send a valid UUID."}
+                    }
+                });
+
+            const std::optional<JobRegistry::Status> status {registry->status(uuid)};
+
+            if (status && (status->state == JobRegistry::State::Queued || status->state == JobRegistry::State::Rendering))
+                return respond(pendingChartResponse(uuid, status->state));
+
+            if (status && status->state == JobRegistry::State::Failed)
+                return respond(failedChartResponse(status->message));
+
+            //the render stages are known as long as the job is in the registry
+            if (status)
+                entry.renderTimings = status->timings;
+
+            const std::optional<ChartMetadata> metadata {findChart(store, index, uuid)};
+
+            if (!metadata)
+            {
+                if (index->isReady())
+                    negatives->insert(uuid);
+
+                return respond(unknownChartResponse());
+            }
+
+            //the first fetch of a lazily stored chart renders it and waits for it as long as a long-poll on /line/status may
+            if (metadata->format == lazySpecFormat)
+            {
+                clock.lap(StageTimings::Stage::Fetch);
+
+                const std::optional<ChartMetadata> queued {renderStoredSpec(uuid, *metadata, entry.trace)};
+
+                if (!queued)
+                    return respond(QHttpServerResponse
+                    {
+                        QJsonObject
+                        {
+                            {"Message", "An internal error (errorcode 103) has occured. Please contact our support via our e-mail %0 ."}
+                        }
+                    });
+
+                if (queued->format != lazySpecFormat)
+                    return chartFunction(uuid, *queued, entry);
+
+                //like the long-poll it waits on the status pool, the writes which finish the render run on the global pool
+                return QtConcurrent::run(statusPool, [registry, index, config, log, tracer, uuid, entry, timingsField]() mutable
+                {
+                    const auto respond = [&entry, timingsField, log, tracer](QHttpServerResponse &&response)
+                    {
+                        return readyResponse(completeResponse(std::move(response), &entry, timingsField, log, tracer));
+                    };
+
+                    const std::optional<JobRegistry::Status> renderStatus {registry->waitForCompletion(uuid, config->current()->statusMaxTimeout)};
+
+                    if (renderStatus && renderStatus->state == JobRegistry::State::Failed)
+                        return respond(failedChartResponse(renderStatus->message));
+
+                    if (renderStatus && renderStatus->state != JobRegistry::State::Done)
+                        return respond(pendingChartResponse(uuid, renderStatus->state));
+
+                    //the wait is covered by the stages of the render
+                    if (renderStatus)
+                        entry.renderTimings = renderStatus->timings;
+
+                    const std::optional<ChartMetadata> rendered {index->find(uuid)};
+
+                    if (!rendered || rendered->format == lazySpecFormat)
+                        return respond(unknownChartResponse());
+
+                    return chartFunction(uuid, *rendered, entry);
+
+                }).unwrap();
+            }
+
+            clock.lap(StageTimings::Stage::Fetch);
+
+            return chartFunction(uuid, *metadata, entry);
+        };
+
+        return QtConcurrent::run(responseFunction, argument, queueTimer, entry).unwrap();
+    });
+
+    httpServer->route("/line/status/<arg>", QHttpServerRequest::Method::Get,
+    [registry = jobRegistry.data(), store = chartStore.data(), index = chartIndex.data(), config = liveConfig.data(), log = accessLog.data(), tracer = spanExporter.data(), pool = statusPool.data()](const QString &argument, const QHttpServerRequest &request) -> QFuture<QHttpServerResponse>
+    {
+        QElapsedTimer queueTimer;
+        queueTimer.start();
+
+        const std::shared_ptr<AccessLog::Entry> entry {std::make_shared<AccessLog::Entry>()};
+        entry->time  = SpanExporter::currentTime();
+        entry->route = "/line/status";
+        entry->trace = TraceContext::childOf(TraceContext::fromTraceparent(request.value("traceparent")));
+
+        LINECHART_PROBE3(request__start, entry->trace.requestId(), entry->route, entry->requestBytes);
+
+        //optional long-poll: ?timeout=<milliseconds> waits until the job is done or failed
+        const int timeout {std::clamp(request.query().queryItemValue("timeout").toInt(), 0, config->current()->statusMaxTimeout)};
+
+        return QtConcurrent::run(pool, [registry, store, index, argument, timeout, entry, queueTimer]()
+        {
+            entry->timings.add(StageTimings::Stage::QueueWait, queueTimer.nsecsElapsed());
+
+            const QUuid uuid {QUuid::fromString(argument)};
+
+            entry->uuid = uuid;
+
+            if (uuid.isNull())
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", "The submitted argument is not an UUID. Please send a valid UUID."}
+                    }
+                };
+
+            const QString uuidString {uuid.toString(QUuid::StringFormat::WithoutBraces)};
+
+            const std::optional<JobRegistry::Status> status {timeout > 0 ? registry->waitForCompletion(uuid, timeout) : registry->status(uuid)};
+
+            //finished jobs are pruned from the registry after a while, the chart stays in the index
+            if (!status && !findChart(store, index, uuid))
+                return QHttpServerResponse
+                {
+                    QJsonObject
+                    {
+                        {"Message", "The submitted UUID is either not linked to any chart or already expired. Please contact our support via our e-mail %0 ."}
+                    }
+                };
+
+            const JobRegistry::State state {status ? status->state : JobRegistry::State::Done};
+
+            QJsonObject statusObject
+            {
+                {"Uuid",   uuidString},
+                {"Status", JobRegistry::stateName(state)}
+            };
+
+            if (state == JobRegistry::State::Queued)
+                statusObject.insert("QueuePosition", status->queuePosition);
+
+            if (state == JobRegistry::State::Done)
+                statusObject.insert("Link", QString{"http://127.0.0.1:50001/line/result/%0"}.arg(uuidString));
+
+            if (state == JobRegistry::State::Failed)
+                statusObject.insert("Message", status->message);
+
+            return QHttpServerResponse
+            {
+                statusObject
+            };
+
+        }).then([entry, config, log, tracer](QHttpServerResponse response)
+        {
+            return completeResponse(std::move(response), entry.get(), config->current()->timingsField, log, tracer);
+        });
+    });
+
+    httpServer->route("/line/ready", QHttpServerRequest::Method::Get,
+    [registry = jobRegistry.data(), monitor = readinessMonitor.data(), config = liveConfig.data(), log = accessLog.data(), tracer = spanExporter.data(), pool = statusPool.data()](const QHttpServerRequest &request) -> QFuture<QHttpServerResponse>
+    {
+        QElapsedTimer queueTimer;
+        queueTimer.start();
+
+        const std::shared_ptr<AccessLog::Entry> entry {std::make_shared<AccessLog::Entry>()};
+        entry->time  = SpanExporter::currentTime();
+        entry->route = "/line/ready";
+        entry->trace = TraceContext::childOf(TraceContext::fromTraceparent(request.value("traceparent")));
+
+        LINECHART_PROBE3(request__start, entry->trace.requestId(), entry->route, entry->requestBytes);
+
+        return QtConcurrent::run(pool, [registry, monitor, entry, queueTimer]()
+        {
+            entry->timings.add(StageTimings::Stage::QueueWait, queueTimer.nsecsElapsed());
+
+            QJsonObject readyObject;
+
+            const QStringList reasons {monitor->check(registry->queuedCount(), &readyObject)};
+
+            if (!reasons.isEmpty())
+            {
+                readyObject.insert("Message", "Not ready.");
+                readyObject.insert("Reasons", QJsonArray::fromStringList(reasons));
+
+                return QHttpServerResponse
+                {
+                    readyObject,
+                    QHttpServerResponder::StatusCode::ServiceUnavailable
+                };
+            }
+
+            readyObject.insert("Message", "Ready.");
+
+            return QHttpServerResponse
+            {
+                readyObject
+            };
+
+        }).then([entry, config, log, tracer](QHttpServerResponse response)
+        {
+            return completeResponse(std::move(response), entry.get(), config->current()->timingsField, log, tracer);
+        });
+    });
+
+    httpServer->route("/line/ping", QHttpServerRequest::Method::Get,
+    [config = liveConfig.data(), log = accessLog.data(), tracer = spanExporter.data()](const QHttpServerRequest &request) -> QFuture<QHttpServerResponse>
+    {
+        QElapsedTimer queueTimer;
+        queueTimer.start();
+
+        AccessLog::Entry entry;
+        entry.time  = SpanExporter::currentTime();
+        entry.route = "/line/ping";
+        entry.trace = TraceContext::childOf(TraceContext::fromTraceparent(request.value("traceparent")));
+
+        LINECHART_PROBE3(request__start, entry.trace.requestId(), entry.route, entry.requestBytes);
+
+        return QtConcurrent::run([config, log, tracer, queueTimer, entry]() mutable
+        {
+            entry.timings.add(StageTimings::Stage::QueueWait, queueTimer.nsecsElapsed());
+
+            return completeResponse(QHttpServerResponse
+            {
+                QJsonObject
+                {
+                    {"Message", "Pong."}
+                }
+            }, &entry, config->current()->timingsField, log, tracer);
+        });
+    });
+
+    if (httpServer->listen(QHostAddress::LocalHost, static_cast<quint16>(port)) == 0)
+        commandlineParser.showHelp(-99);
+
+    qDebug() << QCoreApplication::applicationName() << " is running on port: " << port;
+    qDebug() << "Chart files are read and written with" << (chartStore->usesIoUring() ? "io_uring" : "blocking I/O on the thread pool");
+
+    if (accessLog->isEnabled())
+        qDebug() << "Access log:" << QDir{QApplication::applicationDirPath()}.absoluteFilePath(accessLogFilename);
+
+    if (spanExporter->isEnabled())
+        qDebug() << "Spans are exported to:" << QDir{QApplication::applicationDirPath()}.absoluteFilePath(spanExportFilename);
+
+    /* the indexes are rebuilt in the background, so the server answers right away;
+       until the rebuild is finished findChart() falls back to the store */
+
+    QtConcurrent::run([store = chartStore.data(), index = chartIndex.data(), expiry = expiryIndex.data(), order = evictionOrder.data(), lazyQueue = lazyRenderQueue.data(), idleRendering = initialConfig->idleRendering, interruptedWritesBefore]()
+    {
+        QElapsedTimer elapsedTimer;
+        elapsedTimer.start();
+
+        //the server and the resumed jobs are writing already
+        const int removedTemporaries {store->removeTemporaries(interruptedWritesBefore)};
+
+        if (removedTemporaries > 0)
+            qDebug() << "Removed" << removedTemporaries << "temporary files of interrupted writes";
+
+        //a snapshot written by a graceful shutdown saves the scan, it is only valid once
+        if (index->load(indexSnapshotFilename))
+        {
+            QFile::remove(indexSnapshotFilename);
+
+            index->forEach([expiry, order, lazyQueue, idleRendering](const QUuid &uuid, const ChartMetadata &metadata)
+            {
+                expiry->insert(uuid, metadata.created);
+                order->insert(uuid, metadata.created);
+
+                if (idleRendering && metadata.format == lazySpecFormat)
+                    lazyQueue->enqueue(uuid);
+            });
+
+            index->setReady(true);
+
+            qDebug() << "Loaded" << index->count() << "charts with" << index->totalSize() << "bytes from the index snapshot in" << elapsedTimer.elapsed() << "ms";
+            return;
+        }
+
+        QFile::remove(indexSnapshotFilename);
+
+        //archived first, a chart file left by an interrupted migration replaces its archive record
+        store->scanArchive([index, expiry, order](const QUuid &uuid, const ChartMetadata &metadata)
+        {
+            index->insert(uuid, metadata);
+            expiry->insert(uuid, metadata.created);
+            order->insert(uuid, metadata.created);
+        });
+
+        QStringList locations {store->scan()};
+
+        QtConcurrent::blockingMap(locations, [index, expiry, order, lazyQueue, store, idleRendering](const QString &location)
+        {
+            QUuid uuid;
+            ChartMetadata metadata;
+
+            if (!store->describe(location, &uuid, &metadata))
+                return;
+
+            index->insert(uuid, metadata);
+            expiry->insert(uuid, metadata.created);
+            order->insert(uuid, metadata.created);
+
+            if (idleRendering && metadata.format == lazySpecFormat)
+                lazyQueue->enqueue(uuid);
+        });
+
+        index->setReady(true);
+
+        qDebug() << "Indexed" << index->count() << "charts with" << index->totalSize() << "bytes in" << elapsedTimer.elapsed() << "ms";
+    });
+
+    QFile handoffFile {handoffFilename};
+
+    if (handoffFile.open(QFile::OpenModeFlag::ReadOnly))
+    {
+        QDataStream handoffStream {&handoffFile};
+
+        qint64 handedOff {0};
+
+        while (!handoffStream.atEnd())
+        {
+            RenderJob job;
+            handoffStream >> job;
+
+            if (handoffStream.status() != QDataStream::Status::Ok)
+                break;
+
+            submitRenderJob(job, RenderCoalescer::keyFor(job.spec));
+            ++handedOff;
+        }
+
+        handoffFile.remove();
+
+        qDebug() << "Resumed" << handedOff << "render jobs handed off by the previous instance";
+    }
+
+    /* the first render loads fonts and initializes QtCharts, pay that before the first client does;
+       one warm-up render per render thread, /line/ready reports ready once all of them are finished */
+
+    for (int warmUp {0}; warmUp < renderThreads; ++warmUp)
+    {
+        renderPool->start([monitor = readinessMonitor.data(), config = liveConfig.data(), encoders = encodePool.data()]()
+        {
+            QElapsedTimer elapsedTimer;
+            elapsedTimer.start();
+
+            QFontDatabase::families();
+
+            LineChartSpec spec;
+            spec.xEnd = 2;
+            spec.yEnd = 1;
+            spec.captionToPoints.insert("Warm-up", {{0, 1, 2}, {0, 1, 0}});
+
+            QByteArray imageBytes;
+            renderLineChartPngStreamed(spec, config->current()->pngCompression, encoders, &imageBytes);
+
+            monitor->warmUpFinished();
+
+            qDebug() << "Warm-up render finished in" << elapsedTimer.elapsed() << "ms";
+        });
+    }
+
+    //lazily stored charts are rendered in the background while no other render job is queued or running
+    QTimer idleRenderTimer;
+    QObject::connect(&idleRenderTimer, &QTimer::timeout, &app,
+    [registry = jobRegistry.data(), index = chartIndex.data(), config = liveConfig.data(), lazyQueue = lazyRenderQueue.data(), renderStoredSpec]()
+    {
+        const std::shared_ptr<const ServiceConfig> idleConfig {config->current()};
+
+        if (!idleConfig->idleRendering || registry->activeCount() > 0)
+            return;
+
+        QtConcurrent::run([index, lazyQueue, renderStoredSpec, count = idleConfig->renderThreads]()
+        {
+            for (const QUuid &uuid : lazyQueue->take(count))
+            {
+                const std::optional<ChartMetadata> metadata {index->find(uuid)};
+
+                //fetched, expired or evicted in the meantime
+                if (metadata && metadata->format == lazySpecFormat)
+                    renderStoredSpec(uuid, *metadata, {});
+            }
+        });
+    });
+    idleRenderTimer.start(1000);
+
+    /* hot reload of settings.ini: the new values are published as one snapshot, then pushed into the pools,
+       the callback dispatcher and the readiness monitor; running jobs finish with the snapshot they started with */
+
+    const auto reloadSettings = [&]()
+    {
+        const QSettings reloadedSettings {settingsFilename, QSettings::Format::IniFormat};
+
+        if (reloadedSettings.status() != QSettings::Status::NoError)
+        {
+            qWarning() << "Could not read" << settingsFilename << ", keeping the current settings.";
+            return;
+        }
+
+        if (reloadedSettings.value(PORT_KEY).toULongLong() != port || reloadedSettings.value(IMAGEPATH_KEY).toString() != imagepath)
+            qWarning() << "Changes of" << PORT_KEY << "and" << IMAGEPATH_KEY << "take effect after a restart.";
+
+        const ServiceConfig config {ServiceConfig::fromSettings(reloadedSettings)};
+
+        liveConfig->publish(config);
+
+        renderPool->setMaxThreadCount(config.renderThreads);
+        encodePool->setMaxThreadCount(config.renderThreads);
+        statusPool->setMaxThreadCount(config.statusThreads);
+        callbackDispatcher->setLimits(config.callbackQueueLimit, config.callbackMaxRetries, config.callbackRetryInterval);
+        readinessMonitor->setThresholds(config.readyThresholds);
+        negativeCache->setLimits(config.negativeCacheTtl, config.negativeCacheCapacity);
+        chartCache->setCapacity(config.memoryTier);
+        ImageBufferPool::globalInstance()->setLimits(config.bufferPoolMemory, config.bufferPoolMaxImage);
+        groupCommit->setInterval(config.syncInterval);
+        accessLog->setSampling(config.accessLogSampling, config.accessLogSampleAbove);
+
+        qInfo() << "Reloaded" << settingsFilename;
+    };
+
+    //editors often save by replacing the file, which drops it from the watcher, and emit several changes per save
+    QFileSystemWatcher settingsWatcher {{settingsFilename}};
+
+    QTimer reloadDebounceTimer;
+    reloadDebounceTimer.setSingleShot(true);
+    reloadDebounceTimer.setInterval(500);
+
+    QObject::connect(&reloadDebounceTimer, &QTimer::timeout, &app, reloadSettings);
+
+    QObject::connect(&settingsWatcher, &QFileSystemWatcher::fileChanged, &app, [&](const QString &path)
+    {
+        if (!settingsWatcher.files().contains(path) && QFile::exists(path))
+            settingsWatcher.addPath(path);
+
+        reloadDebounceTimer.start();
+    });
+
+#ifdef Q_OS_UNIX
+    /* graceful shutdown: stop accepting, let the queued renders and callbacks finish until the deadline,
+       hand off what did not start yet, flush the store and persist the chart index for a fast restart */
+
+    UnixSignalWatcher signalWatcher {{SIGTERM, SIGINT, SIGHUP}};
+
+    QObject::connect(&signalWatcher, &UnixSignalWatcher::signalReceived, &app, [&](int signalNumber)
+    {
+        if (readinessMonitor->isShuttingDown())
+            return;
+
+        if (signalNumber == SIGHUP)
+        {
+            reloadSettings();
+            return;
+        }
+
+        qInfo() << "Received signal" << signalNumber << ", shutting down.";
+
+        readinessMonitor->beginShutdown();
+
+        for (QTcpServer * const server : httpServer->servers())
+            server->close();
+
+        jobPruneTimer.stop();
+        expiryTimer.stop();
+        idleRenderTimer.stop();
+        settingsWatcher.removePath(settingsFilename);
+        reloadDebounceTimer.stop();
+
+        const QDeadlineTimer deadline {liveConfig->current()->shutdownDeadline};
+
+        QTimer * const drainTimer {new QTimer {&app}};
+
+        QObject::connect(drainTimer, &QTimer::timeout, &app, [&, drainTimer, deadline]()
+        {
+            if ((jobRegistry->activeCount() > 0 || callbackDispatcher->pendingCount() > 0) && !deadline.hasExpired())
+                return;
+
+            drainTimer->stop();
+
+            renderPool->clear();
+
+            const QVector<QByteArray> handedOff {jobRegistry->takeQueued()};
+
+            //only renders which already started are left, they get what is left of the deadline
+            renderPool->waitForDone(static_cast<int>(deadline.remainingTime()));
+
+            /* their charts are written and published by continuations on the global pool,
+               the snapshot below has to include them */
+            while (jobRegistry->activeCount() > 0 && !deadline.hasExpired())
+                QThread::msleep(10);
+
+            QThreadPool::globalInstance()->waitForDone(static_cast<int>(deadline.remainingTime()));
+
+            //the handoff and the snapshot are written anyway, before the service manager kills the process
+            if (jobRegistry->activeCount() > 0)
+                qWarning() << "The shutdown deadline expired," << jobRegistry->activeCount() << "unfinished render jobs are left out";
+
+            if (!handedOff.isEmpty())
+            {
+                QFile handoffFile {handoffFilename};
+
+                if (handoffFile.open(QFile::OpenModeFlag::WriteOnly | QFile::OpenModeFlag::Append))
+                {
+                    QDataStream handoffStream {&handoffFile};
+
+                    for (const QByteArray &payload : handedOff)
+                    {
+                        handoffFile.write(payload);
+
+                        /* callbacks of identical requests travel as jobs with the same UUID,
+                           on restore they join the flight of the job written right before them */
+
+                        RenderJob job;
+                        QDataStream payloadStream {payload};
+                        payloadStream >> job;
+
+                        for (const RenderCoalescer::Callback &callback : renderCoalescer->complete(RenderCoalescer::keyFor(job.spec)))
+                            handoffStream << RenderJob {job.uuid, job.spec, callback.url, callback.inlineData};
+                    }
+                }
+
+                qInfo() << "Handed off" << handedOff.size() << "queued render jobs";
+            }
+
+            if (!chartStore->flush())
+                qWarning() << "Could not flush the chart store";
+
+            if (chartIndex->isReady() && !chartIndex->save(indexSnapshotFilename))
+                qWarning() << "Could not save the chart index snapshot";
+
+            app.quit();
+        });
+
+        drainTimer->start(100);
+    });
+#endif
+
+    return app.exec();
+}